@@ -0,0 +1,295 @@
+"""
+Benchmark the per-call overhead of the RF24, RF24Network, and RF24Mesh hot paths,
+and the RF24Network throughput for message sizes across the fragmentation boundary.
+
+This requires the pyrf24 package to be built with the ``SIMULATED`` RF24_DRIVER, so
+several radios can talk to each other without any hardware. The results are printed as
+JSON, which can be compared between pyrf24 releases.
+
+See documentation at https://nRF24.github.io/pyRF24
+"""
+
+import argparse
+import json
+import platform
+import threading
+import time
+import tracemalloc
+from importlib.metadata import PackageNotFoundError, version
+from typing import Any, Callable, Dict, List, Optional
+
+from pyrf24 import (
+    MAX_PAYLOAD_SIZE,
+    RF24,
+    RF24_DRIVER,
+    RF24Mesh,
+    RF24Network,
+    RF24NetworkHeader,
+)
+
+if RF24_DRIVER != "SIMULATED":
+    raise SystemExit(
+        "These benchmarks need pyrf24 built with the SIMULATED driver "
+        '(export CMAKE_ARGS="-DRF24_DRIVER=SIMULATED")'
+    )
+from pyrf24 import simulated_medium  # pylint: disable=wrong-import-position
+
+PAYLOAD = bytes(range(32))
+# the largest message that fits in 1 frame (a 32-byte payload minus the 8-byte header)
+FRAME_MESSAGE_SIZE = 24
+
+
+class Stat:
+    """Accumulates the cost of 1 operation."""
+
+    def __init__(self):
+        self.ops = 0
+        self.total_ns = 0
+        self.peak_bytes = 0
+
+    def record(self, func: Callable[[], Any]) -> Any:
+        """Call ``func`` and record its duration and (if `tracemalloc` is tracing) the
+        peak python memory it allocated, including memory freed before it returned."""
+        tracing = tracemalloc.is_tracing()
+        if tracing:
+            traced = tracemalloc.get_traced_memory()[0]
+            tracemalloc.reset_peak()
+        start = time.perf_counter_ns()
+        result = func()
+        elapsed = time.perf_counter_ns() - start
+        if tracing:
+            self.peak_bytes += tracemalloc.get_traced_memory()[1] - traced
+        self.total_ns += elapsed
+        self.ops += 1
+        return result
+
+
+class Benchmark:
+    """Collects the `Stat` of each operation."""
+
+    def __init__(self):
+        self.stats: Dict[str, Stat] = {}
+        # the cost of a call that does nothing (subtracted from the results)
+        self.baseline = Stat()
+        for _ in range(10000):
+            self.baseline.record(lambda: None)
+
+    def measure(self, name: str, func: Callable[[], Any]) -> Any:
+        """Call ``func`` and record its cost as ``name``."""
+        return self.stats.setdefault(name, Stat()).record(func)
+
+    def report(self) -> Dict[str, Dict[str, float]]:
+        base_ns = self.baseline.total_ns / self.baseline.ops
+        base_bytes = self.baseline.peak_bytes / self.baseline.ops
+        results = {}
+        for name, stat in self.stats.items():
+            if not stat.ops:
+                continue
+            results[name] = {
+                "ops": stat.ops,
+                "ns_per_op": max(stat.total_ns / stat.ops - base_ns, 0.0),
+            }
+            if tracemalloc.is_tracing():
+                results[name]["peak_bytes_per_op"] = max(
+                    stat.peak_bytes / stat.ops - base_bytes, 0.0
+                )
+        return results
+
+
+def make_radio(ce_pin: int, csn_pin: int, channel: int) -> RF24:
+    """Begin using a simulated radio (identified by its ``csn_pin``)."""
+    radio = RF24(ce_pin, csn_pin)
+    if not radio.begin():
+        raise OSError(f"simulated radio on CSN {csn_pin} isn't responding")
+    radio.channel = channel
+    return radio
+
+
+def bench_rf24(bench: Benchmark, iterations: int):
+    """RF24.write(), write_fast(), available_pipe(), and read()"""
+    tx_radio = make_radio(22, 0, 10)
+    rx_radio = make_radio(23, 10, 10)
+    for radio in (tx_radio, rx_radio):
+        radio.payload_size = len(PAYLOAD)
+    tx_radio.stop_listening(b"1Node")
+    rx_radio.open_rx_pipe(1, b"1Node")
+    rx_radio.listen = True
+    simulated_medium.advance(1000)  # let the receiver's PLL settle
+
+    for _ in range(iterations):
+        bench.measure("RF24.write", lambda: tx_radio.write(PAYLOAD))
+        has_payload, _pipe = bench.measure(
+            "RF24.available_pipe", rx_radio.available_pipe
+        )
+        if has_payload:
+            bench.measure("RF24.read", lambda: rx_radio.read(len(PAYLOAD)))
+
+    for _ in range(iterations):
+        bench.measure("RF24.write_fast", lambda: tx_radio.write_fast(PAYLOAD))
+        tx_radio.tx_standby()
+        rx_radio.flush_rx()
+
+
+def bench_network(bench: Benchmark, iterations: int):
+    """RF24Network.write(), update(), and read()"""
+    master_radio = make_radio(24, 20, 40)
+    child_radio = make_radio(25, 30, 40)
+    master = RF24Network(master_radio)
+    child = RF24Network(child_radio)
+    master.begin(0)
+    child.begin(0o1)
+    simulated_medium.advance(1000)
+
+    for _ in range(iterations):
+        bench.measure(
+            "RF24Network.write", lambda: child.write(RF24NetworkHeader(0, 1), PAYLOAD)
+        )
+        bench.measure("RF24Network.update", master.update)
+        if master.available():
+            bench.measure("RF24Network.read", master.read)
+
+
+def bench_fragmentation(
+    bench: Benchmark, iterations: int
+) -> Dict[str, Dict[str, float]]:
+    """RF24Network.write() throughput for message sizes across the fragmentation
+    boundary"""
+    master_radio = make_radio(28, 60, 70)
+    child_radio = make_radio(29, 70, 70)
+    master = RF24Network(master_radio)
+    child = RF24Network(child_radio)
+    master.begin(0)
+    child.begin(0o1)
+    simulated_medium.advance(1000)
+
+    # the master must reassemble the fragments as they arrive (in another thread)
+    receiving = threading.Event()
+    receiving.set()
+    received = [0]  # the number of messages
+    headers_size = 7 * 4  # see RF24Network.read_all()
+
+    def serve():
+        buffer = bytearray(MAX_PAYLOAD_SIZE * 8)
+        while receiving.is_set():
+            master.update()
+            headers, _ = master.read_all(buffer=buffer)
+            received[0] += len(headers) // headers_size
+
+    sizes = [FRAME_MESSAGE_SIZE, FRAME_MESSAGE_SIZE + 1, FRAME_MESSAGE_SIZE * 4]
+    sizes = sorted(set(size for size in sizes if size < MAX_PAYLOAD_SIZE))
+    sizes.append(MAX_PAYLOAD_SIZE)
+    results = {}
+    server = threading.Thread(target=serve)
+    server.start()
+    try:
+        for size in sizes:
+            message = bytes(i & 0xFF for i in range(size))
+            received[0] = 0
+            delivered = 0
+            start = time.perf_counter_ns()
+            for _ in range(iterations):
+                delivered += bench.measure(
+                    f"RF24Network.write[{size}B]",
+                    lambda: child.write(RF24NetworkHeader(0, 1), message),
+                )
+            deadline = time.monotonic() + 1
+            while received[0] < delivered and time.monotonic() < deadline:
+                time.sleep(0.0001)
+            elapsed = (time.perf_counter_ns() - start) / 1e9
+            results[f"{size}B"] = {
+                "frames_per_message": -(-size // FRAME_MESSAGE_SIZE),
+                "delivered": delivered,
+                "received": received[0],
+                "bytes_per_second": received[0] * size / elapsed,
+            }
+    finally:
+        receiving.clear()
+        server.join()
+    return results
+
+
+def bench_mesh(bench: Benchmark, iterations: int):
+    """RF24Mesh.write() and update()"""
+    master_radio = make_radio(26, 40, 97)
+    child_radio = make_radio(27, 50, 97)
+    master_network = RF24Network(master_radio)
+    child_network = RF24Network(child_radio)
+    master = RF24Mesh(master_radio, master_network)
+    child = RF24Mesh(child_radio, child_network)
+    master.node_id = 0
+    child.node_id = 1
+    if not master.begin():
+        raise OSError("the mesh master failed to begin")
+
+    # the master must respond to the child's address request (in another thread)
+    connecting = threading.Event()
+    connecting.set()
+
+    def serve():
+        while connecting.is_set():
+            master.update()
+            master.dhcp()
+
+    server = threading.Thread(target=serve)
+    server.start()
+    try:
+        if not child.begin():
+            raise OSError("the mesh child failed to get an address from the master")
+    finally:
+        connecting.clear()
+        server.join()
+
+    for _ in range(iterations):
+        bench.measure("RF24Mesh.write", lambda: child.write(PAYLOAD, 1))
+        bench.measure("RF24Mesh.update", master.update)
+        while master_network.available():
+            master_network.read()
+        child.update()
+
+
+def main(argv: Optional[List[str]] = None):
+    parser = argparse.ArgumentParser(description="Benchmark the pyrf24 hot paths.")
+    parser.add_argument(
+        "-n", "--iterations", type=int, default=2000, help="calls per operation"
+    )
+    parser.add_argument("-o", "--output", help="write the JSON results to this file")
+    parser.add_argument(
+        "-m",
+        "--trace-memory",
+        action="store_true",
+        help="also report the peak python memory allocated per call "
+        "(tracing slows every call, so ns_per_op is inflated)",
+    )
+    args = parser.parse_args(argv)
+
+    if args.trace_memory:
+        tracemalloc.start()
+    bench = Benchmark()
+    bench_rf24(bench, args.iterations)
+    bench_network(bench, args.iterations)
+    bench_mesh(bench, args.iterations)
+    throughput = bench_fragmentation(bench, args.iterations)
+
+    try:
+        pyrf24_version = version("pyrf24")
+    except PackageNotFoundError:
+        pyrf24_version = "unknown"
+    report = {
+        "pyrf24": pyrf24_version,
+        "driver": RF24_DRIVER,
+        "python": platform.python_version(),
+        "machine": platform.machine(),
+        "iterations": args.iterations,
+        "trace_memory": args.trace_memory,
+        "results": bench.report(),
+        "network_throughput": throughput,
+    }
+    output = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as json_file:
+            json_file.write(output + "\n")
+    print(output)
+
+
+if __name__ == "__main__":
+    main()
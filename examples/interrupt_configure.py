@@ -18,22 +18,7 @@ from pyrf24 import (
     RF24_TX_DS,
 )
 
-try:
-    import gpiod  # type: ignore[import-untyped]
-    from gpiod.line import Edge  # type: ignore[import-untyped]
-except ImportError as exc:
-    raise ImportError(
-        "This script requires gpiod installed for observing the IRQ pin. Please run\n"
-        "\n    pip install gpiod\n\nMore details at https://pypi.org/project/gpiod/"
-    ) from exc
-
-gpio_chip_path = "/dev/gpiochip0"
-gpio_chip = gpiod.Chip(gpio_chip_path)
-
 print(__file__)  # print example name
-# print gpio chip info
-info = gpio_chip.get_info()
-print(f"Using {info.name} [{info.label}] ({info.num_lines} lines)")
 
 
 ########### USER CONFIGURATION ###########
@@ -53,6 +38,8 @@ radio = RF24(CE_PIN, CSN_PIN)
 
 # select your digital input pin that's connected to the IRQ pin on the nRF24L01
 IRQ_PIN = 24
+# the GPIO chip (character device) that IRQ_PIN belongs to
+gpio_chip_path = "/dev/gpiochip0"
 
 # For this example, we will use different addresses
 # An address need to be a buffer protocol object (bytearray)
@@ -97,11 +84,10 @@ tx_payloads = (b"Ping ", b"Pong ", b"Radio", b"1FAIL")
 ack_payloads = (b"Yak ", b"Back", b" ACK")
 
 
-def interrupt_handler():
+def interrupt_handler(flags: int):
     """This function is called when IRQ pin is detected active LOW"""
     print("\tIRQ pin went active LOW.")
-    # get (and clear) status flags that triggered the event
-    flags = radio.clear_status_flags()
+    # `flags` are the (already cleared) status flags that triggered the event
     print("\t", end="", flush=True)
     radio.print_status(flags)
     if pl_iterator[0] == 0:
@@ -122,26 +108,21 @@ def interrupt_handler():
 
 
 # setup IRQ GPIO pin
-irq_line = gpiod.request_lines(
-    path=gpio_chip_path,
-    consumer="pyrf24/examples/interrupt",  # optional
-    config={IRQ_PIN: gpiod.LineSettings(edge_detection=Edge.FALLING)},
-)
+radio.attach_irq(IRQ_PIN, gpio_chip_path)
 
 
-def _wait_for_irq(timeout: float = 5):
+def _wait_for_irq(timeout: float = 5) -> int:
     """Wait till IRQ_PIN goes active (LOW).
     IRQ pin is LOW when activated. Otherwise it is always HIGH
+
+    Returns the status flags that triggered the event (0 if timed out).
     """
     # wait up to ``timeout`` seconds for event to be detected.
-    if not irq_line.wait_edge_events(timeout):
+    # this also gets (and clears) the status flags that triggered the event
+    flags = radio.wait_irq(int(timeout * 1000))
+    if not flags:
         print(f"\tInterrupt event not detected for {timeout} seconds!")
-        return False
-    # read event from kernel buffer
-    for event in irq_line.read_edge_events():
-        if event.line_offset == IRQ_PIN and event.event_type is event.Type.FALLING_EDGE:
-            return True
-    return False
+    return flags
 
 
 def master():
@@ -161,8 +142,9 @@ def master():
     print("    Pinging slave node for an ACK payload...")
     pl_iterator[0] = 0
     radio.start_fast_write(tx_payloads[0])
-    if _wait_for_irq():
-        interrupt_handler()
+    flags = _wait_for_irq()
+    if flags:
+        interrupt_handler(flags)
 
     # on "data sent" test
     print("\nConfiguring IRQ pin to only ignore 'on data ready' event")
@@ -170,8 +152,9 @@ def master():
     print("    Pinging slave node again...")
     pl_iterator[0] = 1
     radio.start_fast_write(tx_payloads[1])
-    if _wait_for_irq():
-        interrupt_handler()
+    flags = _wait_for_irq()
+    if flags:
+        interrupt_handler(flags)
 
     # trigger slave node to exit by filling the slave node's RX FIFO
     print("\nSending one extra payload to fill RX FIFO on slave node.")
@@ -189,8 +172,9 @@ def master():
     radio.flush_tx()  # just in case any previous tests failed
     pl_iterator[0] = 2
     radio.start_fast_write(tx_payloads[3])
-    if _wait_for_irq():
-        interrupt_handler()
+    flags = _wait_for_irq()
+    if flags:
+        interrupt_handler(flags)
 
     # all 3 ACK payloads received were 4 bytes each, and RX FIFO is full
     # so, fetching 12 bytes from the RX FIFO also flushes RX FIFO
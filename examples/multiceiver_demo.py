@@ -103,13 +103,17 @@ def slave(timeout=10):
     for pipe_n, addr in enumerate(addresses):
         radio.open_rx_pipe(pipe_n, addr)
     radio.listen = True  # put base station into RX mode
+    # a buffer big enough to hold all 3 levels of the RX FIFO
+    buffer = bytearray(radio.payload_size * 3)
     start_timer = time.monotonic()  # start timer
     while time.monotonic() - start_timer < timeout:
-        has_payload, pipe_number = radio.available_pipe()
-        if has_payload:
-            length = radio.payload_size  # grab the payload length
+        # drain the RX FIFO in 1 call; returns (pipe number, length) pairs
+        meta = radio.read_many(3, buffer)
+        offset = 0
+        for pipe_number, length in zip(meta[0::2], meta[1::2]):
             # unpack payload
-            node_id, payload_id = struct.unpack("<ii", radio.read(radio.payload_size))
+            node_id, payload_id = struct.unpack_from("<ii", buffer, offset)
+            offset += length
             # show the pipe number that received the payload
             print(
                 f"Received {length} bytes on pipe {pipe_number} from node {node_id}.",
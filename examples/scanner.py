@@ -74,43 +74,27 @@ def scan(timeout: int = 30):
 
     signals = [0] * 126  # store the signal count for each channel
     sweeps = 0  # keep track of the number of sweeps made through all channels
-    curr_channel = 0
+
+    def count_signals(_pass: int, detections: bytes):
+        # count any RPD or packet detection as interference
+        for channel, detected in enumerate(detections):
+            signals[channel] += detected > 0
+
     end_time = time.monotonic() + timeout  # start the timer
     while time.monotonic() < end_time:
-        radio.channel = curr_channel
-        radio.listen = True  # start a RX session
-        time.sleep(0.00013)  # wait 130 microseconds
-        found_signal = radio.rpd
-        radio.listen = False  # end the RX session
-        found_signal = found_signal or radio.rpd or radio.available()
-
-        # count signal as interference
-        signals[curr_channel] += found_signal
-        # clear the RX FIFO if a signal was detected/captured
-        if found_signal:
-            radio.flush_rx()  # flush the RX FIFO because it asserts the RPD flag
-        endl = False
-        if curr_channel >= 124:
-            sweeps += 1
-            if int(sweeps / 100) > 0:
-                endl = True
-                sweeps = 0
+        # sweep all channels (listening 130 microseconds on each channel)
+        radio.scan(range(126), callback=count_signals)
+        sweeps += 1
+        endl = sweeps >= 100
 
         # output the signal counts per channel
-        sig_cnt = signals[curr_channel]
         print(
-            f"{min(15, sig_cnt):X}" if sig_cnt else "-",
-            end="" if curr_channel < 125 else "\n" if endl else "\r",
+            "".join(f"{min(15, sig_cnt):X}" if sig_cnt else "-" for sig_cnt in signals),
+            end="\n" if endl else "\r",
         )
-        curr_channel = curr_channel + 1 if curr_channel < 125 else 0
         if endl:
+            sweeps = 0
             signals = [0] * 126  # reset the signal counts for new line
-
-    # finish printing results and end with a new line
-    while curr_channel < len(signals) - 1:
-        curr_channel += 1
-        sig_cnt = signals[curr_channel]
-        print(f"{min(15, sig_cnt):X}" if sig_cnt else "-", end="")
     print()
 
 
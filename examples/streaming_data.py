@@ -6,7 +6,7 @@ See documentation at https://nRF24.github.io/pyRF24
 
 import time
 
-from pyrf24 import RF24, RF24_DRIVER, RF24_PA_LOW, RF24_TX_DF
+from pyrf24 import RF24, RF24_DRIVER, RF24_PA_LOW
 
 print(__file__)  # print example name
 
@@ -81,38 +81,18 @@ def master(count: int = 1, size: int = 32):
     radio.payload_size = size  # the default is the maximum 32 bytes
 
     radio.listen = False  # ensures the nRF24L01 is in TX mode
-    for cnt in range(count):  # transmit the same payloads this many times
+    # concatenate all the payloads into 1 contiguous buffer
+    stream = b"".join(make_buffer(i, size) for i in range(size))
+    for _ in range(count):  # transmit the same payloads this many times
         radio.flush_tx()  # clear the TX FIFO so we can use all 3 levels
-        # NOTE the write_only parameter does not initiate sending
-        buf_iter = 0  # iterator of payloads for the while loop
-        failures = 0  # keep track of manual retries
-        start_timer = time.monotonic() * 1000  # start timer
-        while buf_iter < size:  # cycle through all the payloads
-            buf = make_buffer(buf_iter, size)  # make a payload
-            if not radio.write_fast(buf):
-                flags = radio.get_status_flags()
-                if flags & int(RF24_TX_DF):
-                    failures += 1  # increment manual retries
-                    # transmitting a payload failed.
-                    # we need to reset the TX_DF flag and the radio's CE pin
-                    radio.ce_pin(False)
-                    radio.clear_status_flags(int(RF24_TX_DF))
-                    radio.ce_pin(True)
-                # else the radio's TX FIFO is full; just continue the loop
-
-                if failures > 99 and buf_iter < 7 and cnt < 2:
-                    # we need to prevent an infinite loop
-                    print("Make sure slave() node is listening. Quitting master_fifo()")
-                    buf_iter = size + 1  # be sure to exit the while loop
-                    radio.flush_tx()  # discard all payloads in TX FIFO
-                    break
-            buf_iter += 1
-        radio.failure_detected = 0
-        radio.tx_standby()
-        failures += radio.failure_detected
-        end_timer = time.monotonic() * 1000  # end timer
+        # keep the TX FIFO full (natively) until all payloads are sent
+        sent, failures, elapsed = radio.write_stream(stream, size, max_retries=99)
+        if sent < size or failures > 99:
+            # we need to prevent an infinite loop
+            print("Make sure slave() node is listening. Quitting master()")
+            break
         print(
-            f"Transmission took {end_timer - start_timer} ms with",
+            f"Transmission took {elapsed / 1000} ms with",
             f"{failures} failures detected.",
         )
 
@@ -2,8 +2,11 @@
 #include "pyRF24.h"
 #include "pyRF24Network.h"
 #include "pyRF24Mesh.h"
+#include "pyRadioGroup.h"
 
-PYBIND11_MODULE(pyrf24, m)
+// All bindings serialize access to the radio with its SPI mutex (see RadioLock in pyRF24.h),
+// so this module is safe to use without the GIL on free-threaded python builds.
+PYBIND11_MODULE(pyrf24, m, py::mod_gil_not_used())
 {
     m.doc() = "A Python module that wraps all RF24 C++ library's API";
     py::options options;
@@ -11,4 +14,5 @@ PYBIND11_MODULE(pyrf24, m)
     init_rf24(m);
     init_rf24network(m);
     init_rf24mesh(m);
+    init_radio_group(m);
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "pyLinkAdapter.h"
+#include <algorithm>
+
+const char* LinkAdapter::reason_name(uint8_t reason)
+{
+    static const char* const names[] = {
+        "raise_pa",
+        "lower_rate",
+        "backoff",
+        "more_retries",
+        "raise_rate",
+        "lower_pa",
+        "shorter_delay",
+        "fewer_retries",
+    };
+    return reason <= FEWER_RETRIES ? names[reason] : "unknown";
+}
+
+uint8_t LinkAdapter::rate_rank(uint8_t data_rate)
+{
+    // RF24_1MBPS = 0, RF24_2MBPS = 1, RF24_250KBPS = 2
+    static const uint8_t ranks[] = {1, 2, 0};
+    return data_rate < 3 ? ranks[data_rate] : 1;
+}
+
+uint8_t LinkAdapter::rate_of(uint8_t rank)
+{
+    static const uint8_t rates[] = {2, 0, 1};
+    return rank < 3 ? rates[rank] : 0;
+}
+
+LinkSettings LinkAdapter::clamp(const LinkSettings& settings) const
+{
+    LinkSettings result;
+    result.delay = std::min(std::max(settings.delay, bounds.min.delay), bounds.max.delay);
+    result.count = std::min(std::max(settings.count, bounds.min.count), bounds.max.count);
+    result.pa_level = std::min(std::max(settings.pa_level, bounds.min.pa_level), bounds.max.pa_level);
+    result.rate_rank = std::min(std::max(settings.rate_rank, bounds.min.rate_rank), bounds.max.rate_rank);
+    return result;
+}
+
+LinkAdapter::Destination& LinkAdapter::destination(const uint8_t* address, const LinkSettings& current)
+{
+    for (size_t i = 0; i < destinations.size(); ++i) {
+        if (memcmp(destinations[i].address, address, 5) == 0) {
+            if (i)
+                std::rotate(destinations.begin(), destinations.begin() + i, destinations.begin() + i + 1);
+            return destinations.front();
+        }
+    }
+    if (destinations.size() == DESTINATIONS)
+        destinations.pop_back();
+    Destination dest;
+    memcpy(dest.address, address, 5);
+    dest.settings = clamp(current);
+    memset(&dest.current, 0, sizeof(LinkWindow));
+    memset(&dest.last, 0, sizeof(LinkWindow));
+    dest.clean_windows = 0;
+    dest.decisions = 0;
+    destinations.insert(destinations.begin(), dest);
+    return destinations.front();
+}
+
+bool LinkAdapter::record(Destination& dest, bool delivered, uint8_t arc, bool rpd, uint64_t timestamp)
+{
+    LinkWindow& current = dest.current;
+    ++current.sends;
+    current.failures += !delivered;
+    current.arc_total += delivered ? arc : dest.settings.count;
+    current.rpd_count += rpd;
+    if (current.sends < window)
+        return false;
+
+    dest.last = current;
+    memset(&current, 0, sizeof(LinkWindow));
+    uint8_t reason;
+    if (!adapt(dest, reason))
+        return false;
+    ++dest.decisions;
+    Decision& decision = decisions[(decision_head + decision_count) % DECISIONS];
+    if (decision_count < DECISIONS)
+        ++decision_count;
+    else
+        decision_head = (decision_head + 1) % DECISIONS;
+    decision.timestamp = timestamp;
+    memcpy(decision.address, dest.address, 5);
+    decision.reason = reason;
+    decision.settings = dest.settings;
+    decision.window = dest.last;
+    return true;
+}
+
+bool LinkAdapter::adapt(Destination& dest, uint8_t& reason)
+{
+    const LinkWindow& stats = dest.last;
+    LinkSettings& settings = dest.settings;
+    double mean_arc = static_cast<double>(stats.arc_total) / stats.sends;
+    bool lossy = stats.failures * 10 > stats.sends || (settings.count && mean_arc > settings.count / 2.0);
+    if (lossy) {
+        dest.clean_windows = 0;
+        bool busy = stats.rpd_count * 2 > stats.sends;
+        if (busy && settings.delay < bounds.max.delay) {
+            settings.delay = std::min(static_cast<uint8_t>(settings.delay + 2), bounds.max.delay);
+            reason = BACKOFF;
+        }
+        else if (settings.pa_level < bounds.max.pa_level) {
+            ++settings.pa_level;
+            reason = RAISE_PA;
+        }
+        else if (settings.rate_rank > bounds.min.rate_rank) {
+            --settings.rate_rank;
+            reason = LOWER_RATE;
+        }
+        else if (settings.count < bounds.max.count) {
+            settings.count = bounds.max.count;
+            reason = MORE_RETRIES;
+        }
+        else if (settings.delay < bounds.max.delay) {
+            ++settings.delay;
+            reason = BACKOFF;
+        }
+        else
+            return false;
+        return true;
+    }
+    if (stats.failures || mean_arc >= 0.25) {
+        dest.clean_windows = 0;
+        return false;
+    }
+    if (++dest.clean_windows < 2)
+        return false;
+    dest.clean_windows = 0;
+    if (settings.rate_rank < bounds.max.rate_rank) {
+        ++settings.rate_rank;
+        reason = RAISE_RATE;
+    }
+    else if (settings.pa_level > bounds.min.pa_level) {
+        --settings.pa_level;
+        reason = LOWER_PA;
+    }
+    else if (settings.delay > bounds.min.delay) {
+        --settings.delay;
+        reason = SHORTER_DELAY;
+    }
+    else if (settings.count > bounds.min.count) {
+        --settings.count;
+        reason = FEWER_RETRIES;
+    }
+    else
+        return false;
+    return true;
+}
+
+std::vector<LinkAdapter::Decision> LinkAdapter::get_decisions() const
+{
+    std::vector<Decision> result;
+    result.reserve(decision_count);
+    for (size_t i = 0; i < decision_count; ++i)
+        result.push_back(decisions[(decision_head + i) % DECISIONS]);
+    return result;
+}
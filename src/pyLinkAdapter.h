@@ -0,0 +1,153 @@
+#ifndef PYLINKADAPTER_H
+#define PYLINKADAPTER_H
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/** The radio settings that a LinkAdapter tunes for each destination. */
+struct LinkSettings
+{
+    /** The auto-retransmit delay (ARD) in steps of 250 microseconds. */
+    uint8_t delay;
+    /** The auto-retransmit count (ARC). */
+    uint8_t count;
+    /** A rf24_pa_dbm_e value. */
+    uint8_t pa_level;
+    /** The speed rank of the data rate: 0 (250 kbps), 1 (1 Mbps), or 2 (2 Mbps). See LinkAdapter::rate_rank(). */
+    uint8_t rate_rank;
+
+    bool operator==(const LinkSettings& other) const
+    {
+        return delay == other.delay && count == other.count && pa_level == other.pa_level && rate_rank == other.rate_rank;
+    }
+};
+
+/** The inclusive range of settings that a LinkAdapter may choose from. */
+struct LinkBounds
+{
+    LinkSettings min;
+    LinkSettings max;
+};
+
+/** The outcomes of the transmissions to 1 destination. */
+struct LinkWindow
+{
+    uint32_t sends;
+    uint32_t failures;
+    /** The sum of the auto-retransmit counts (a failed transmission counts all retries). */
+    uint32_t arc_total;
+    /** The number of transmissions that were preceded by a received power >= -64 dBm (see RF24::testRPD()). */
+    uint32_t rpd_count;
+};
+
+/**
+ * An opt-in link-adaptation policy.
+ *
+ * The outcome of every transmission is recorded per destination address. At the end of each window
+ * (of ``window`` transmissions to the same destination), the destination's settings are adjusted:
+ *
+ * - A lossy link (more than 10% failures, or a mean ARC above half the retry count) is made more robust.
+ *   If the channel was busy (RPD asserted before most transmissions), then the retransmit delay is increased
+ *   to back off. Otherwise, the PA level is raised, then the data rate is lowered, then the retries are increased.
+ * - After 2 consecutive clean windows (no failures and a mean ARC below 0.25), the data rate is raised,
+ *   then the PA level is lowered, then the retransmit delay and count are reduced (1 step per window).
+ *
+ * This class only decides; the radio is (re)configured by RF24Wrapper. It is guarded by the radio's SPI mutex.
+ */
+class LinkAdapter
+{
+public:
+    enum Reason
+    {
+        RAISE_PA,
+        LOWER_RATE,
+        BACKOFF,
+        MORE_RETRIES,
+        RAISE_RATE,
+        LOWER_PA,
+        SHORTER_DELAY,
+        FEWER_RETRIES,
+    };
+
+    static const char* reason_name(uint8_t reason);
+
+    /** A change of a destination's settings. */
+    struct Decision
+    {
+        /** CLOCK_MONOTONIC timestamp (in nanoseconds) of the decision. */
+        uint64_t timestamp;
+        uint8_t address[5];
+        uint8_t reason;
+        LinkSettings settings;
+        /** The window that triggered the decision. */
+        LinkWindow window;
+    };
+
+    struct Destination
+    {
+        uint8_t address[5];
+        LinkSettings settings;
+        /** The window being recorded. */
+        LinkWindow current;
+        /** The last completed window. */
+        LinkWindow last;
+        uint8_t clean_windows;
+        uint32_t decisions;
+    };
+
+    /** The maximum number of destinations tracked (the least recently used is forgotten). */
+    static const size_t DESTINATIONS = 16;
+    /** The number of most recent decisions kept. */
+    static const size_t DECISIONS = 64;
+
+    LinkAdapter() : enabled(false), window(32), decision_head(0), decision_count(0)
+    {
+    }
+
+    bool enabled;
+    uint32_t window;
+    LinkBounds bounds;
+
+    /** The speed rank of a rf24_datarate_e value (RF24_250KBPS < RF24_1MBPS < RF24_2MBPS). */
+    static uint8_t rate_rank(uint8_t data_rate);
+    /** The rf24_datarate_e value of a speed rank. */
+    static uint8_t rate_of(uint8_t rank);
+
+    /**
+     * Get the state of a destination ``address`` (5 bytes). An unknown destination starts with
+     * the ``current`` radio settings (clamped to the bounds).
+     */
+    Destination& destination(const uint8_t* address, const LinkSettings& current);
+
+    /** Record the outcome of 1 transmission to ``dest``. Returns true if its settings changed. */
+    bool record(Destination& dest, bool delivered, uint8_t arc, bool rpd, uint64_t timestamp);
+
+    /** Forget all destinations and decisions. */
+    void reset()
+    {
+        destinations.clear();
+        decision_head = 0;
+        decision_count = 0;
+    }
+
+    const std::vector<Destination>& get_destinations() const
+    {
+        return destinations;
+    }
+
+    /** Get the kept decisions (oldest first). */
+    std::vector<Decision> get_decisions() const;
+
+private:
+    /** Most recently used first. */
+    std::vector<Destination> destinations;
+    Decision decisions[DECISIONS];
+    size_t decision_head;
+    size_t decision_count;
+
+    /** Adjust the settings of ``dest`` for its completed window. Returns false if nothing could be changed. */
+    bool adapt(Destination& dest, uint8_t& reason);
+    LinkSettings clamp(const LinkSettings& settings) const;
+};
+
+#endif // PYLINKADAPTER_H
@@ -1,43 +1,411 @@
 #include <pybind11/pybind11.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+#include <linux/gpio.h>
+#include <cstring>
 #include "pyRF24.h"
+#if defined(RF24_SIMULATED)
+    #include "nrf24_model.h"
+#endif
 
-void throw_ba_exception(void)
+void emit_deprecation_warning(std::string message)
 {
-    PyErr_SetString(PyExc_TypeError, "buf parameter must be bytes or bytearray");
-    py::error_already_set();
+    PyErr_WarnEx(PyExc_DeprecationWarning, message.c_str(), 1);
 }
 
-char* get_bytes_or_bytearray_str(py::object buf)
+void IrqPin::request(const std::string& chip, uint32_t pin)
 {
-    PyObject* py_ba;
-    py_ba = buf.ptr();
-    if (PyByteArray_Check(py_ba))
-        return PyByteArray_AsString(py_ba);
-    else if (PyBytes_Check(py_ba))
-        return PyBytes_AsString(py_ba);
-    else
-        throw_ba_exception();
+    std::lock_guard<std::mutex> lock(fd_mutex);
+    if (users)
+        throw std::runtime_error("the IRQ pin is in use (by wait_irq(), read_timestamped(), or the event monitor)");
+    close_line();
+    int chip_fd = open(chip.c_str(), O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0) {
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, chip.c_str());
+        throw py::error_already_set();
+    }
+    gpio_v2_line_request line_request;
+    memset(&line_request, 0, sizeof(line_request));
+    line_request.offsets[0] = pin;
+    line_request.num_lines = 1;
+    strncpy(line_request.consumer, "pyrf24 IRQ", GPIO_MAX_NAME_SIZE - 1);
+    line_request.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    int ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &line_request);
+    int error = errno;
+    ::close(chip_fd);
+    if (ret < 0) {
+        errno = error;
+        PyErr_SetFromErrnoWithFilename(PyExc_OSError, chip.c_str());
+        throw py::error_already_set();
+    }
+    fd = line_request.fd;
+    // so that queued edge events can be discarded without blocking
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+void IrqPin::release()
+{
+    std::lock_guard<std::mutex> lock(fd_mutex);
+    if (users)
+        throw std::runtime_error("the IRQ pin is in use (by wait_irq(), read_timestamped(), or the event monitor)");
+    close_line();
+}
+
+void IrqPin::close_line()
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    std::lock_guard<std::mutex> lock(edges_mutex);
+    edge_count = 0;
+}
+
+int IrqPin::wait(int timeout_ms)
+{
+    LineUse line(*this);
+    if (line.fd < 0)
+        return -EBADF;
+    // an already active (LOW) IRQ pin will not produce another falling edge
+    gpio_v2_line_values values;
+    values.bits = 0;
+    values.mask = 1;
+    if (ioctl(line.fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) == 0 && !(values.bits & 1)) {
+        read_events(line.fd);
+        return 1;
+    }
+    pollfd pfd;
+    pfd.fd = line.fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ret = poll(&pfd, 1, timeout_ms);
+    if (ret < 0)
+        return -errno;
+    if (ret == 0)
+        return 0;
+    read_events(line.fd);
+    return 1;
+}
+
+void IrqPin::read_events(int line)
+{
+    gpio_v2_line_event events[16];
+    ssize_t length;
+    while ((length = read(line, events, sizeof(events))) > 0) {
+        std::lock_guard<std::mutex> lock(edges_mutex);
+        size_t count = static_cast<size_t>(length) / sizeof(gpio_v2_line_event);
+        // keep the oldest edges; payloads are dropped (not overwritten) when the RX FIFO is full
+        for (size_t i = 0; i < count && edge_count < EDGES; ++i)
+            edges[edge_count++] = events[i].timestamp_ns;
+    }
+}
+
+uint8_t IrqPin::take_edges(uint64_t* timestamps)
+{
+    LineUse line(*this);
+    if (line.fd < 0)
+        return 0;
+    read_events(line.fd);
+    std::lock_guard<std::mutex> lock(edges_mutex);
+    uint8_t count = edge_count;
+    memcpy(timestamps, edges, count * sizeof(uint64_t));
+    edge_count = 0;
+    return count;
+}
+
+void RF24Wrapper::open_event_fd()
+{
+    if (event_fd >= 0)
+        return;
+    event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        throw py::error_already_set();
+    }
+}
+
+void RF24Wrapper::close_event_fd()
+{
+    if (event_fd >= 0) {
+        ::close(event_fd);
+        event_fd = -1;
+    }
+}
+
+void RF24Wrapper::event_monitor_loop(std::chrono::microseconds poll_interval)
+{
+    // wake up periodically while waiting on the IRQ pin, so that stop_event_monitor() is not blocked
+    const int irq_timeout_ms = 50;
+    while (event_monitor_running.load(std::memory_order_acquire)) {
+        uint8_t flags = 0;
+        if (irq_pin.is_requested()) {
+            int result = irq_pin.wait(irq_timeout_ms);
+            if (result > 0) {
+                std::lock_guard<std::mutex> lock(spi_mutex);
+                RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+                flags = RF24::clearStatusFlags() & RF24_IRQ_ALL;
+            }
+            else if (result < 0 && result != -EINTR)
+                std::this_thread::sleep_for(poll_interval);
+        }
+        else {
+            std::this_thread::sleep_for(poll_interval);
+            std::lock_guard<std::mutex> lock(spi_mutex);
+            RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+            flags = RF24::update() & RF24_IRQ_ALL;
+            if (flags)
+                RF24::clearStatusFlags(flags);
+        }
+        if (flags) {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            if (!pending_events) {
+                uint64_t increment = 1;
+                ssize_t written = write(event_fd, &increment, sizeof(increment));
+                (void)written; // only fails if the counter would overflow (it is already readable)
+            }
+            pending_events |= flags;
+        }
+    }
+}
+
+uint8_t RF24Wrapper::take_events(uint8_t mask)
+{
+    if (event_fd < 0)
+        return 0;
+    std::lock_guard<std::mutex> lock(events_mutex);
+    uint8_t events = pending_events & mask;
+    if (events && !(pending_events &= static_cast<uint8_t>(~mask))) {
+        // event_fd is readable while (and only while) events are pending
+        uint64_t counter;
+        ssize_t consumed = read(event_fd, &counter, sizeof(counter));
+        (void)consumed;
+    }
+    return events;
+}
 
-    return NULL;
+/**
+ * Wait for ``dwell``. This sleeps, unless ``dwell`` is shorter than the kernel's timer slack (by which
+ * any sleep may overshoot), in which case this spins. With the SIMULATED driver, this advances the
+ * simulated medium's virtual clock instead.
+ */
+static void dwell_for(std::chrono::microseconds dwell)
+{
+#if defined(RF24_SIMULATED)
+    delayMicroseconds(static_cast<uint32_t>(dwell.count()));
+#else
+    static const int timer_slack_ns = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    if (timer_slack_ns < 0 || dwell >= std::chrono::nanoseconds(timer_slack_ns)) {
+        std::this_thread::sleep_for(dwell);
+        return;
+    }
+    auto deadline = std::chrono::steady_clock::now() + dwell;
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+#endif
 }
 
-int get_bytes_or_bytearray_ln(py::object buf)
+void RF24Wrapper::scan_pass(const std::vector<uint8_t>& channels, std::chrono::microseconds dwell, uint8_t* flags)
 {
-    PyObject* py_ba;
-    py_ba = buf.ptr();
-    if (PyByteArray_Check(py_ba))
-        return PyByteArray_Size(py_ba);
-    else if (PyBytes_Check(py_ba))
-        return PyBytes_Size(py_ba);
+    uint8_t channel;
+    bool was_listening;
+    {
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24Wrapper> changed(*this);
+        channel = RF24::getChannel();
+        was_listening = RF24::read_register(CONFIG) & _BV(PRIM_RX);
+        RF24::startListening();
+    }
+    // the SPI mutex is released between channels, so other threads wait for 1 dwell (not the whole pass)
+    for (size_t i = 0; i < channels.size(); ++i) {
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24Wrapper> changed(*this);
+        RF24::ce(LOW);
+        RF24::setChannel(channels[i]);
+        RF24::ce(HIGH);
+        // the dwell time includes the RX settling time (130 us)
+        dwell_for(dwell);
+        uint8_t detected = RF24::testRPD() ? SCAN_RPD : 0;
+        RF24::ce(LOW);
+        if (RF24::available()) {
+            detected |= SCAN_PACKET;
+            RF24::flush_rx(); // a captured payload would persist in the RX FIFO
+        }
+        flags[i] = detected;
+    }
+    std::lock_guard<std::mutex> lock(spi_mutex);
+    RegistersChanged<RF24Wrapper> changed(*this);
+    RF24::setChannel(channel);
+    if (was_listening)
+        RF24::ce(HIGH);
     else
-        throw_ba_exception();
+        RF24::stopListening();
+}
 
-    return 0;
+py::object RF24Wrapper::scan(py::iterable channels, uint32_t dwell_us, uint32_t passes, py::object out, py::object callback)
+{
+    std::vector<uint8_t> sweep;
+    for (py::handle channel : channels) {
+        int number = channel.cast<int>();
+        if (number < 0 || number > 125)
+            throw py::value_error("channels must be in range [0, 125]");
+        sweep.push_back(static_cast<uint8_t>(number));
+    }
+    if (sweep.empty())
+        throw py::value_error("channels must not be empty");
+    const size_t counts_size = sweep.size() * 2 * sizeof(uint32_t);
+    if (out.is_none())
+        out = py::module::import("array").attr("array")("I", py::bytes(std::string(counts_size, '\0')));
+
+    BufferView counts(out, true);
+    if (counts.size() < static_cast<Py_ssize_t>(counts_size))
+        throw py::value_error("out is too small for 2 counts per channel");
+    std::vector<uint8_t> flags(sweep.size());
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+        {
+            py::gil_scoped_release release;
+            scan_pass(sweep, std::chrono::microseconds(dwell_us), flags.data());
+        }
+        uint8_t* data = counts.data();
+        for (size_t i = 0; i < sweep.size(); ++i) {
+            for (uint8_t bit = 0; bit < 2; ++bit) {
+                uint32_t count;
+                memcpy(&count, data, sizeof(count)); // out may not be aligned
+                count += (flags[i] >> bit) & 1;
+                memcpy(data, &count, sizeof(count));
+                data += sizeof(count);
+            }
+        }
+        if (!callback.is_none()) {
+            py::object proceed = callback(pass, py::bytes(reinterpret_cast<char*>(flags.data()), flags.size()));
+            if (proceed.ptr() == Py_False)
+                break;
+        }
+        if (PyErr_CheckSignals() != 0)
+            throw py::error_already_set();
+    }
+    return out;
 }
 
-void emit_deprecation_warning(std::string message)
+void RF24Wrapper::read_snapshot(uint8_t* blob)
 {
-    PyErr_WarnEx(PyExc_DeprecationWarning, message.c_str(), 1);
+    RadioStats::Timer timer(stats, RadioStats::REGISTER_READ);
+    for (uint8_t reg = 0; reg < SNAPSHOT_ADDRESSES; ++reg) {
+        if (reg == RX_ADDR_P0 || reg == RX_ADDR_P1 || reg == TX_ADDR) {
+            uint8_t* address = blob + SNAPSHOT_ADDRESSES + (reg == RX_ADDR_P0 ? 0 : (reg == RX_ADDR_P1 ? 5 : 10));
+            RF24::read_register(reg, address, 5);
+            blob[reg] = address[0];
+        }
+        else if (reg >= 0x18 && reg <= 0x1B)
+            blob[reg] = 0; // reserved (test) registers
+        else
+            blob[reg] = RF24::read_register(reg);
+    }
+}
+
+void RF24Wrapper::write_snapshot(const uint8_t* target)
+{
+    uint8_t current[REGISTER_SNAPSHOT_SIZE];
+    read_snapshot(current);
+    RadioStats::Timer timer(stats, RadioStats::REGISTER_WRITE);
+
+    uint8_t width = target[SETUP_AW] & 3;
+    if (width && width != (current[SETUP_AW] & 3))
+        RF24::setAddressWidth(width + 2);
+    const uint8_t rate_bits = _BV(RF_DR_LOW) | _BV(RF_DR_HIGH);
+    if ((target[RF_SETUP] ^ current[RF_SETUP]) & rate_bits) {
+        uint8_t rate = target[RF_SETUP] & rate_bits;
+        RF24::setDataRate(rate == _BV(RF_DR_HIGH) ? RF24_2MBPS : (rate == _BV(RF_DR_LOW) ? RF24_250KBPS : RF24_1MBPS));
+    }
+    if ((target[RF_SETUP] ^ current[RF_SETUP]) & (_BV(RF_PWR_LOW) | _BV(RF_PWR_HIGH) | 1))
+        RF24::setPALevel((target[RF_SETUP] >> 1) & 3, target[RF_SETUP] & 1);
+    if (target[RF_CH] != current[RF_CH])
+        RF24::setChannel(target[RF_CH]);
+    if (target[SETUP_RETR] != current[SETUP_RETR])
+        RF24::setRetries(target[SETUP_RETR] >> ARD, target[SETUP_RETR] & 0x0F);
+    uint8_t size = target[RX_PW_P0];
+    if (size && size <= 32 && (size != current[RX_PW_P0] || size != RF24::getPayloadSize()))
+        RF24::setPayloadSize(size);
+
+    // disabling pipe 0's auto-ack also disables ACK payloads, so EN_AA precedes FEATURE
+    uint8_t auto_ack = target[EN_AA] & 0x3F;
+    if (auto_ack != (current[EN_AA] & 0x3F)) {
+        if (auto_ack == 0x3F || !auto_ack)
+            RF24::setAutoAck(auto_ack != 0); // 1 write for all pipes
+        else {
+            for (uint8_t pipe = 0; pipe < 6; ++pipe) {
+                bool enable = auto_ack & _BV(pipe);
+                if (enable != static_cast<bool>(current[EN_AA] & _BV(pipe)))
+                    RF24::setAutoAck(pipe, enable);
+            }
+        }
+        if (!(auto_ack & 1))
+            current[FEATURE] &= static_cast<uint8_t>(~_BV(EN_ACK_PAY)); // keep the snapshot of FEATURE accurate
+    }
+    const uint8_t feature_bits = _BV(EN_DPL) | _BV(EN_ACK_PAY) | _BV(EN_DYN_ACK);
+    uint8_t feature = target[FEATURE] & feature_bits;
+    if (feature != (current[FEATURE] & feature_bits) || target[DYNPD] != current[DYNPD]) {
+        RF24::disableDynamicPayloads(); // clears FEATURE and DYNPD
+        // enableAckPayload() alone only sets DYNPD for pipes 0 and 1
+        if (feature & _BV(EN_DPL) && (!(feature & _BV(EN_ACK_PAY)) || target[DYNPD] & 0x3C))
+            RF24::enableDynamicPayloads();
+        if (feature & _BV(EN_ACK_PAY))
+            RF24::enableAckPayload();
+        if (feature & _BV(EN_DYN_ACK))
+            RF24::enableDynamicAck();
+    }
+
+    uint8_t config = target[CONFIG];
+    uint8_t changed_config = config ^ current[CONFIG];
+    if (changed_config & (_BV(EN_CRC) | _BV(CRCO))) {
+        if (config & _BV(EN_CRC))
+            RF24::setCRCLength(config & _BV(CRCO) ? RF24_CRC_16 : RF24_CRC_8);
+        else
+            RF24::disableCRC();
+    }
+    if (changed_config & RF24_IRQ_ALL)
+        RF24::setStatusFlags(static_cast<uint8_t>(~config & RF24_IRQ_ALL)); // the CONFIG bits mask the IRQ events
+    if (config & _BV(PWR_UP) && changed_config & _BV(PWR_UP))
+        RF24::powerUp();
+
+    // In TX mode, pipe 0 receives the ACKs (at the TX address), so it is left to stopListening().
+    // In RX mode, pipe 0 is reopened after the TX address (which also overwrites RX_ADDR_P0).
+    const bool listening = config & _BV(PRIM_RX);
+    const bool tx_changed = memcmp(target + SNAPSHOT_ADDRESSES + 10, current + SNAPSHOT_ADDRESSES + 10, RF24::addr_width) != 0;
+    if (listening && tx_changed)
+        RF24::openWritingPipe(target + SNAPSHOT_ADDRESSES + 10);
+    // pipes 2-5 share the upper bytes of pipe 1's address
+    auto pipe_address = [](const uint8_t* blob, uint8_t pipe, uint8_t* address) {
+        memcpy(address, blob + SNAPSHOT_ADDRESSES + (pipe ? 5 : 0), 5);
+        if (pipe > 1)
+            address[0] = blob[RX_ADDR_P0 + pipe];
+    };
+    // only the pipes that differ from the snapshot are reopened (or closed);
+    // a closed pipe's address is restored by opening it before closing it
+    for (uint8_t pipe = listening ? 0 : 1; pipe < 6; ++pipe) {
+        uint8_t target_address[5], current_address[5];
+        pipe_address(target, pipe, target_address);
+        pipe_address(current, pipe, current_address);
+        bool enable = target[EN_RXADDR] & _BV(pipe);
+        bool was_enabled = current[EN_RXADDR] & _BV(pipe);
+        bool moved = (!pipe && tx_changed) || memcmp(target_address, current_address, pipe > 1 ? 1 : RF24::addr_width);
+        if (moved || (enable && !was_enabled))
+            RF24::openReadingPipe(pipe, target_address);
+        if (!enable && (moved || was_enabled))
+            RF24::closeReadingPipe(pipe);
+    }
+    if (listening) {
+        if (changed_config & _BV(PRIM_RX))
+            RF24::startListening();
+    }
+    else if (changed_config & _BV(PRIM_RX) || tx_changed)
+        RF24::stopListening(target + SNAPSHOT_ADDRESSES + 10);
+
+    if (!(config & _BV(PWR_UP)) && changed_config & _BV(PWR_UP))
+        RF24::powerDown();
 }
 
 void init_rf24(py::module& m)
@@ -145,7 +513,7 @@ void init_rf24(py::module& m)
         // *****************************************************************************
         // ***************************** functions that take no args & have no overloads
 
-        .def("flush_tx", &RF24Wrapper::flush_tx, R"docstr(
+        .def("flush_tx", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::flush_tx), R"docstr(
             flush_tx()
 
             Flush all 3 levels of the radio's TX FIFO.
@@ -153,7 +521,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("flush_rx", &RF24Wrapper::flush_rx, R"docstr(
+        .def("flush_rx", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::flush_rx), R"docstr(
             flush_rx()
 
             Flush all 3 levels of the radio's RX FIFO.
@@ -161,7 +529,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("disableCRC", &RF24Wrapper::disableCRC, R"docstr(
+        .def("disableCRC", reconfiguring<RF24Wrapper>(&RF24Wrapper::disableCRC), R"docstr(
             disableCRC()
 
             Disable the radio's CRC feature.
@@ -172,7 +540,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("getCRCLength", &RF24Wrapper::getCRCLength, R"docstr(
+        .def("getCRCLength", spi_locked<RF24Wrapper>(&RF24Wrapper::get_crc_length), R"docstr(
             getCRCLength() -> pyrf24.rf24_crclength_e
 
             Get the current setting of the radio's CRC Length.
@@ -180,7 +548,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("getChannel", &RF24Wrapper::getChannel, R"docstr(
+        .def("getChannel", spi_locked<RF24Wrapper>(&RF24Wrapper::get_channel), R"docstr(
             getChannel() -> int
 
             Get the current setting of the radio's channel.
@@ -188,7 +556,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("getDataRate", &RF24Wrapper::getDataRate, R"docstr(
+        .def("getDataRate", spi_locked<RF24Wrapper>(&RF24Wrapper::get_data_rate), R"docstr(
             getDataRate() -> pyrf24.rf24_datarate_e
 
             Get the current setting of the radio's Data Rate.
@@ -196,19 +564,19 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("get_dynamic_payload_size", &RF24Wrapper::getDynamicPayloadSize, R"docstr(
+        .def("get_dynamic_payload_size", spi_locked<RF24Wrapper, RadioStats::REGISTER_READ>(&RF24Wrapper::getDynamicPayloadSize), R"docstr(
             get_dynamic_payload_size() -> int
 
             Get the Dynamic Payload Size of the next available payload in the radio's RX FIFO.
         )docstr")
 
-        .def("getDynamicPayloadSize", &RF24Wrapper::getDynamicPayloadSize, R"docstr(
+        .def("getDynamicPayloadSize", spi_locked<RF24Wrapper, RadioStats::REGISTER_READ>(&RF24Wrapper::getDynamicPayloadSize), R"docstr(
             getDynamicPayloadSize() -> int
         )docstr")
 
         // *****************************************************************************
 
-        .def("getPALevel", &RF24Wrapper::getPALevel, R"docstr(
+        .def("getPALevel", spi_locked<RF24Wrapper, RadioStats::REGISTER_READ>(&RF24Wrapper::getPALevel), R"docstr(
             getPALevel() -> pyrf24.rf24_pa_dbm_e
 
             Get the current setting of the radio's Power Amplitude Level.
@@ -226,7 +594,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("enableAckPayload", &RF24Wrapper::enableAckPayload, R"docstr(
+        .def("enableAckPayload", reconfiguring<RF24Wrapper>(&RF24Wrapper::enableAckPayload), R"docstr(
             enableAckPayload()
 
             Enable the radio's Ack Payload feature.
@@ -234,7 +602,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("enable_dynamic_ack", &RF24Wrapper::enableDynamicAck, R"docstr(
+        .def("enable_dynamic_ack", reconfiguring<RF24Wrapper>(&RF24Wrapper::enableDynamicAck), R"docstr(
             enable_dynamic_ack()
 
             Enable the radio's Dynamic Ack feature.
@@ -244,13 +612,13 @@ void init_rf24(py::module& m)
             the cheap chinese Si24R1 clones.
         )docstr")
 
-        .def("enableDynamicAck", &RF24Wrapper::enableDynamicAck, R"docstr(
+        .def("enableDynamicAck", reconfiguring<RF24Wrapper>(&RF24Wrapper::enableDynamicAck), R"docstr(
             enableDynamicAck()
         )docstr")
 
         // *****************************************************************************
 
-        .def("enableDynamicPayloads", &RF24Wrapper::enableDynamicPayloads, R"docstr(
+        .def("enableDynamicPayloads", reconfiguring<RF24Wrapper>(&RF24Wrapper::enableDynamicPayloads), R"docstr(
             enableDynamicPayloads()
 
             Enable the radio's Dynamic Payloads feature.
@@ -258,7 +626,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("disableDynamicPayloads", &RF24Wrapper::disableDynamicPayloads, R"docstr(
+        .def("disableDynamicPayloads", reconfiguring<RF24Wrapper>(&RF24Wrapper::disableDynamicPayloads), R"docstr(
             disableDynamicPayloads()
 
             Disable the radio's Dynamic Payloads feature.
@@ -266,7 +634,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("powerDown", &RF24Wrapper::powerDown, R"docstr(
+        .def("powerDown", reconfiguring<RF24Wrapper>(&RF24Wrapper::powerDown), R"docstr(
             powerDown()
 
             Power down the radio.
@@ -277,7 +645,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("powerUp", &RF24Wrapper::powerUp, R"docstr(
+        .def("powerUp", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::powerUp), R"docstr(
             powerUp()
 
             Power up the radio.
@@ -285,32 +653,32 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("print_details", &RF24Wrapper::printDetails, R"docstr(
+        .def("print_details", gil_released<RF24Wrapper>(&RF24Wrapper::printDetails), R"docstr(
             print_details()
 
             Print out details about the radio's configuration.
         )docstr")
 
-        .def("printDetails", &RF24Wrapper::printDetails, R"docstr(
+        .def("printDetails", gil_released<RF24Wrapper>(&RF24Wrapper::printDetails), R"docstr(
             printDetails()
         )docstr")
 
         // *****************************************************************************
 
-        .def("print_pretty_details", &RF24Wrapper::printPrettyDetails, R"docstr(
+        .def("print_pretty_details", gil_released<RF24Wrapper>(&RF24Wrapper::printPrettyDetails), R"docstr(
             print_pretty_details()
 
             Print out details about the radio's configuration. This function differs from
             `print_details()` as the output for this function is more human-friendly/readable.
         )docstr")
 
-        .def("printPrettyDetails", &RF24Wrapper::printPrettyDetails, R"docstr(
+        .def("printPrettyDetails", gil_released<RF24Wrapper>(&RF24Wrapper::printPrettyDetails), R"docstr(
             printPrettyDetails()
         )docstr")
 
         // *****************************************************************************
 
-        .def("sprintf_pretty_details", &RF24Wrapper::sprintfDetails, R"docstr(
+        .def("sprintf_pretty_details", gil_released<RF24Wrapper>(&RF24Wrapper::sprintfDetails), R"docstr(
             sprintf_pretty_details() -> str
 
             Put details about the radio's configuration into a string. This function differs from
@@ -319,25 +687,64 @@ void init_rf24(py::module& m)
             :Returns: A string that describes the radio's details.
         )docstr")
 
-        .def("sprintfPrettyDetails", &RF24Wrapper::sprintfDetails, R"docstr(
+        .def("sprintfPrettyDetails", gil_released<RF24Wrapper>(&RF24Wrapper::sprintfDetails), R"docstr(
             sprintfPrettyDetails() -> str
         )docstr")
 
         // *****************************************************************************
 
-        .def("reuse_tx", &RF24Wrapper::reUseTX, R"docstr(
+        .def("snapshot_registers", &RF24Wrapper::snapshot_registers, R"docstr(
+            snapshot_registers() -> bytes
+
+            Read all of the radio's registers at once. This is much faster than reading the
+            radio's configuration with several attributes (or `sprintf_pretty_details()`), so it
+            can be used to save an operating profile (ie. for BLE advertising or a scanner) and
+            switch back to it with `restore_registers()`.
+
+            :Returns: A 45 byte `bytes` object. Bytes 0 to 29 are the values of the registers
+                at addresses 0x00 to 0x1D (only the first byte of multi-byte registers, and 0 for the
+                reserved registers 0x18 to 0x1B). Bytes 30 to 44 are the full 5-byte values of
+                RX_ADDR_P0, RX_ADDR_P1, and TX_ADDR.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("restore_registers", &RF24Wrapper::restore_registers, R"docstr(
+            restore_registers(blob: Buffer) -> None
+
+            Reconfigure the radio to match a snapshot taken with `snapshot_registers()`.
+
+            Only the settings that differ from the radio's current configuration are written,
+            using the same routines as the corresponding attributes and functions (so this object's
+            cached state, like `payload_size` and `dynamic_payloads`, stays in sync).
+            This includes the radio's RX/TX mode (`listen`) and power state (`power`).
+
+            :param Buffer blob: A snapshot returned by `snapshot_registers()`.
+
+            :raises ValueError: if the ``blob`` is not 45 bytes long.
+
+            .. note::
+                The read-only registers (STATUS, OBSERVE_TX, RPD, and FIFO_STATUS) are not restored.
+                The same payload size (RX_PW_P0) is restored for all pipes, and the per-pipe dynamic
+                payloads (DYNPD) are restored as `dynamic_payloads` and `ack_payloads` configure them.
+        )docstr",
+             py::arg("blob"))
+
+        // *****************************************************************************
+
+        .def("reuse_tx", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::reUseTX), R"docstr(
             reuse_tx()
 
             Re-use the 1\ :sup:`st` level of the radio's TX FIFO.
         )docstr")
 
-        .def("reUseTX", &RF24Wrapper::reUseTX, R"docstr(
+        .def("reUseTX", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::reUseTX), R"docstr(
             reUseTX()
         )docstr")
 
         // *****************************************************************************
 
-        .def("start_listening", &RF24Wrapper::startListening, R"docstr(
+        .def("start_listening", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::startListening), R"docstr(
             start_listening()
 
             Start listening on the pipes opened for receiving.
@@ -368,7 +775,7 @@ void init_rf24(py::module& m)
                 for proper auto-ack functionality.
         )docstr")
 
-        .def("startListening", &RF24Wrapper::startListening, R"docstr(
+        .def("startListening", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::startListening), R"docstr(
             startListening()
 
             Put the radio into RX mode.
@@ -376,14 +783,14 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("stop_const_carrier", &RF24Wrapper::stopConstCarrier, R"docstr(
+        .def("stop_const_carrier", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::stopConstCarrier), R"docstr(
             stop_const_carrier()
 
             End transmitting a constant carrier wave. This function also sets the `power` to `False`
             as recommended by the datasheet.
         )docstr")
 
-        .def("stopConstCarrier", &RF24Wrapper::stopConstCarrier, R"docstr(
+        .def("stopConstCarrier", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::stopConstCarrier), R"docstr(
             stopConstCarrier()
         )docstr")
 
@@ -410,7 +817,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("testRPD", &RF24Wrapper::testRPD, R"docstr(
+        .def("testRPD", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::testRPD), R"docstr(
             testRPD() -> bool
 
             :Returns: `True` if a signal (above -64 dbm) was detected in RX mode, otherwise `False`.
@@ -418,7 +825,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("rxFifoFull", &RF24Wrapper::rxFifoFull, R"docstr(
+        .def("rxFifoFull", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::rxFifoFull), R"docstr(
             rxFifoFull() -> bool
 
             :Returns: `True` if all 3 levels of the radio's RX FIFO are occupied, otherwise `False`.
@@ -426,7 +833,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("what_happened", &RF24Wrapper::what_happened, R"docstr(
+        .def("what_happened", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::what_happened), R"docstr(
             what_happened() -> Tuple[bool, bool, bool]
 
             Call this function when the radio's IRQ pin is active LOW.
@@ -447,13 +854,13 @@ void init_rf24(py::module& m)
                 :py:meth:`~pyrf24.RF24.mask_irq()`
         )docstr")
 
-        .def("whatHappened", &RF24Wrapper::what_happened, R"docstr(
+        .def("whatHappened", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::what_happened), R"docstr(
             whatHappened() -> Tuple[bool, bool, bool]
         )docstr")
 
         // *****************************************************************************
 
-        .def("available_pipe", &RF24Wrapper::available_pipe, R"docstr(
+        .def("available_pipe", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::available_pipe), R"docstr(
             available_pipe() -> Tuple[bool, int]
 
             Similar to :py:meth:`~pyrf24.RF24.available()`, but additionally returns the pipe
@@ -470,7 +877,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("get_arc", &RF24Wrapper::getARC, R"docstr(
+        .def("get_arc", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::getARC), R"docstr(
             get_arc() -> int
 
             Returns automatic retransmission count (ARC_CNT)
@@ -480,14 +887,14 @@ void init_rf24(py::module& m)
             :Returns: Returned values range from 0 to 15.
         )docstr")
 
-        .def("getARC", &RF24Wrapper::getARC, R"docstr(
+        .def("getARC", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::getARC), R"docstr(
             getARC() -> int
         )docstr")
 
         // *****************************************************************************
         // **************************************** functions that take args
 
-        .def("set_radiation", &RF24Wrapper::set_radiation, R"docstr(
+        .def("set_radiation", reconfiguring<RF24Wrapper>(&RF24Wrapper::set_radiation), R"docstr(
             set_radiation(level: rf24_pa_dbm_e, speed: rf24_datarate_e, lna_enable: bool = True)
 
             Configure the RF_SETUP register in 1 SPI transaction.
@@ -507,14 +914,14 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("level"), py::arg("speed"), py::arg("lna_enable") = true)
 
-        .def("setRadiation", &RF24Wrapper::set_radiation, R"docstr(
+        .def("setRadiation", reconfiguring<RF24Wrapper>(&RF24Wrapper::set_radiation), R"docstr(
             setRadiation(level: rf24_pa_dbm_e, speed: rf24_datarate_e, lna_enable: bool = True)
         )docstr",
              py::arg("level"), py::arg("speed"), py::arg("lna_enable") = true)
 
         // *****************************************************************************
 
-        .def("set_retries", &RF24Wrapper::setRetries, R"docstr(
+        .def("set_retries", reconfiguring<RF24Wrapper>(&RF24Wrapper::setRetries), R"docstr(
             set_retries(delay: int, count: int)
 
             Configure the radio's auto-retries feature.
@@ -527,14 +934,14 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("delay"), py::arg("count"))
 
-        .def("setRetries", &RF24Wrapper::setRetries, R"docstr(
+        .def("setRetries", reconfiguring<RF24Wrapper>(&RF24Wrapper::setRetries), R"docstr(
             setRetries(delay: int, count: int)
         )docstr",
              py::arg("delay"), py::arg("count"))
 
         // *****************************************************************************
 
-        .def("setCRCLength", &RF24Wrapper::setCRCLength, R"docstr(
+        .def("setCRCLength", reconfiguring<RF24Wrapper>(&RF24Wrapper::setCRCLength), R"docstr(
             setCRCLength(length: rf24_crclength_e)
 
             Configure the radio's CRC Length feature.
@@ -548,7 +955,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("setChannel", &RF24Wrapper::setChannel, R"docstr(
+        .def("setChannel", reconfiguring<RF24Wrapper>(&RF24Wrapper::setChannel), R"docstr(
             setChannel(channel: int)
 
             Set the current setting of the radio's channel.
@@ -557,7 +964,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("setDataRate", &RF24Wrapper::setDataRate, R"docstr(
+        .def("setDataRate", reconfiguring<RF24Wrapper>(&RF24Wrapper::setDataRate), R"docstr(
             setDataRate(rate: rf24_datarate_e)
 
             Configure the radio's Data Rate feature.
@@ -569,7 +976,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("setAddressWidth", &RF24Wrapper::setAddressWidth, R"docstr(
+        .def("setAddressWidth", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::setAddressWidth), R"docstr(
             setAddressWidth(width: int)
 
             Configure the radio's Address Width feature.
@@ -581,7 +988,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("close_rx_pipe", &RF24Wrapper::closeReadingPipe, R"docstr(
+        .def("close_rx_pipe", reconfiguring<RF24Wrapper>(&RF24Wrapper::closeReadingPipe), R"docstr(
             close_rx_pipe(pipe: int)
 
             Close a data pipe for receiving.
@@ -591,14 +998,14 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("pipe"))
 
-        .def("closeReadingPipe", &RF24Wrapper::closeReadingPipe, R"docstr(
+        .def("closeReadingPipe", reconfiguring<RF24Wrapper>(&RF24Wrapper::closeReadingPipe), R"docstr(
             closeReadingPipe(pipe: int)
         )docstr",
              py::arg("pipe"))
 
         // *****************************************************************************
 
-        .def("toggle_all_pipes", &RF24Wrapper::toggleAllPipes, R"docstr(
+        .def("toggle_all_pipes", reconfiguring<RF24Wrapper>(&RF24Wrapper::toggleAllPipes), R"docstr(
             toggle_all_pipes(enable: bool)
 
             Open or close all pipes with 1 SPI transaction. This does not alter the addresses assigned to
@@ -609,14 +1016,14 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("enable"))
 
-        .def("toggleAllPipes", &RF24Wrapper::toggleAllPipes, R"docstr(
+        .def("toggleAllPipes", reconfiguring<RF24Wrapper>(&RF24Wrapper::toggleAllPipes), R"docstr(
             toggleAllPipes(enable: bool)
         )docstr",
              py::arg("enable"))
 
         // *****************************************************************************
 
-        .def("start_const_carrier", &RF24Wrapper::startConstCarrier, R"docstr(
+        .def("start_const_carrier", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::startConstCarrier), R"docstr(
             start_const_carrier(level: rf24_pa_dbm_e, channel: int)
 
             Start a constant carrier wave. This is used (in conjunction with `rpd`) to test the
@@ -628,13 +1035,13 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("level"), py::arg("channel"))
 
-        .def("startConstCarrier", &RF24Wrapper::startConstCarrier, R"docstr(
+        .def("startConstCarrier", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::startConstCarrier), R"docstr(
             startConstCarrier(level: rf24_pa_dbm_e, channel: int)
         )docstr")
 
         // *****************************************************************************
 
-        .def("set_pa_level", &RF24Wrapper::setPALevel, R"docstr(
+        .def("set_pa_level", reconfiguring<RF24Wrapper>(&RF24Wrapper::setPALevel), R"docstr(
             set_pa_level(level: rf24_pa_dbm_e, lna_enable: bool = True)
 
             Configure the radio's Power Amplitude Level.
@@ -647,7 +1054,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("level"), py::arg("lna_enable") = true)
 
-        .def("setPALevel", &RF24Wrapper::setPALevel, R"docstr(
+        .def("setPALevel", reconfiguring<RF24Wrapper>(&RF24Wrapper::setPALevel), R"docstr(
             setPALevel(level: rf24_pa_dbm_e, lna_enable: bool = True)
         )docstr",
              py::arg("level"), py::arg("lna_enable") = true)
@@ -657,6 +1064,8 @@ void init_rf24(py::module& m)
         .def(
             "mask_irq", [](RF24Wrapper& self, bool tx_ok, bool tx_fail, bool rx_ready) {
             emit_deprecation_warning(std::string("`mask_irq()` is deprecated. Use `set_status_flags()` instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.maskIRQ(tx_ok, tx_fail, rx_ready); }, R"docstr(
             mask_irq(tx_ok: bool, tx_fail: bool, rx_ready: bool)
 
@@ -679,6 +1088,8 @@ void init_rf24(py::module& m)
         .def(
             "maskIRQ", [](RF24Wrapper& self, bool tx_ok, bool tx_fail, bool rx_ready) {
             emit_deprecation_warning(std::string("`maskIRQ()` is deprecated. Use `setStatusFlags()` instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.maskIRQ(tx_ok, tx_fail, rx_ready); }, R"docstr(
             maskIRQ(tx_ok: bool, tx_fail: bool, rx_ready: bool)
         )docstr",
@@ -686,7 +1097,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("set_status_flags", &RF24::setStatusFlags, R"docstr(
+        .def("set_status_flags", reconfiguring<RF24Wrapper>(&RF24::setStatusFlags), R"docstr(
             set_status_flags(flags: int = RF24_IRQ_NONE.value) -> None
 
             Set which flags shall be reflected on the radio's IRQ pin (when active LOW).
@@ -707,14 +1118,14 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("flags") = RF24_IRQ_NONE)
 
-        .def("setStatusFlags", &RF24::setStatusFlags, R"docstr(
+        .def("setStatusFlags", reconfiguring<RF24Wrapper>(&RF24::setStatusFlags), R"docstr(
             setStatusFlags(flags: int = RF24_IRQ_NONE.value) -> None
         )docstr",
              py::arg("flags") = RF24_IRQ_NONE)
 
         // *****************************************************************************
 
-        .def("clear_status_flags", &RF24::clearStatusFlags, R"docstr(
+        .def("clear_status_flags", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24::clearStatusFlags), R"docstr(
             clear_status_flags(flags: int = RF24_IRQ_ALL.value) -> int
 
             Clear the Status flags that caused an interrupt event.
@@ -747,7 +1158,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("flags") = RF24_IRQ_ALL)
 
-        .def("clearStatusFlags", &RF24::clearStatusFlags, R"docstr(
+        .def("clearStatusFlags", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24::clearStatusFlags), R"docstr(
             clearStatusFlags(flags: int = RF24_IRQ_ALL.value) -> int
         )docstr",
              py::arg("flags") = RF24_IRQ_ALL)
@@ -773,7 +1184,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("update", &RF24::update, R"docstr(
+        .def("update", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24::update), R"docstr(
             update() -> int
 
             Get an updated STATUS byte from the radio.
@@ -800,7 +1211,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("ce_pin", &RF24::ce, R"docstr(
+        .def("ce_pin", spi_locked<RF24Wrapper, RadioStats::CE_TOGGLE>(&RF24::ce), R"docstr(
             ce_pin(level: bool) -> None
 
             Set radio's CE (Chip Enable) pin state.
@@ -818,7 +1229,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("level"))
 
-        .def("ce", &RF24::ce, R"docstr(
+        .def("ce", spi_locked<RF24Wrapper, RadioStats::CE_TOGGLE>(&RF24::ce), R"docstr(
             ce(level: bool) -> None
         )docstr",
              py::arg("level"))
@@ -853,6 +1264,331 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("length") = 0)
 
+        // *****************************************************************************
+
+        .def("read_into", &RF24Wrapper::read_into, R"docstr(
+            read_into(buffer: Buffer, offset: int = 0) -> int
+
+            Fetch the next available payload from the radio's RX FIFO directly into a
+            pre-allocated buffer. Unlike `read()`, this function does not allocate any memory.
+
+            :param Buffer buffer: A writable and contiguous object that supports python's
+                buffer protocol (ie. a `bytearray`, `memoryview`, `array.array`, `mmap.mmap`,
+                or numpy array).
+            :param int offset: The index (in bytes) of ``buffer`` at which to start writing
+                the payload. Defaults to ``0``.
+
+            :Returns: The number of bytes written to ``buffer``. This is the length of the
+                dynamic payload (if `dynamic_payloads` is enabled) or the `payload_size`.
+                Zero is returned if the dynamic payload was corrupted (and the RX FIFO was
+                flushed).
+            :Raises:
+                - `IndexError` if ``offset`` is outside the ``buffer``'s range.
+                - `ValueError` if there is not enough room in ``buffer`` (after ``offset``)
+                  for the payload. In this case, the payload remains in the RX FIFO.
+
+            .. code-block:: python
+
+                buffer = bytearray(32)
+                if radio.available():
+                    length = radio.read_into(buffer)
+                    payload = memoryview(buffer)[:length]
+        )docstr",
+             py::arg("buffer"), py::arg("offset") = 0)
+
+        // *****************************************************************************
+
+        .def("read_many", &RF24Wrapper::read_many, R"docstr(
+            read_many(max_count: int, buffer: Buffer) -> bytes
+
+            Drain up to ``max_count`` payloads from the radio's RX FIFO into a pre-allocated buffer.
+            This is much faster than calling `available_pipe()` and `read()` in a python loop
+            because the loop is executed natively (with the GIL released).
+
+            :param int max_count: The maximum number of payloads to read. Accepted values
+                range [0, 255].
+            :param Buffer buffer: A writable and contiguous object that supports python's
+                buffer protocol (ie. a `bytearray` or `memoryview`). The payloads are written
+                back-to-back starting at index 0. Fetching stops early when the next payload
+                does not fit in the remaining space (leaving it in the RX FIFO).
+
+            :Returns: A `bytes` object of (pipe number, payload length) pairs; 2 bytes per
+                payload read. Its length divided by 2 is the number of payloads read.
+
+            .. code-block:: python
+
+                buffer = bytearray(32 * 3)
+                meta = radio.read_many(3, buffer)
+                offset = 0
+                for pipe, length in zip(meta[0::2], meta[1::2]):
+                    print(f"pipe {pipe}:", buffer[offset : offset + length])
+                    offset += length
+        )docstr",
+             py::arg("max_count"), py::arg("buffer"))
+
+        // *****************************************************************************
+
+        .def("attach_irq", &RF24Wrapper::attach_irq, R"docstr(
+            attach_irq(pin: int, chip: str = "/dev/gpiochip0") -> None
+
+            Use the radio's IRQ pin (via the Linux GPIO character device) so that `wait_irq()`
+            can sleep until the radio has an event to report (instead of polling the radio over SPI).
+
+            :param int pin: The GPIO line offset (on the ``chip``) connected to the radio's IRQ pin.
+            :param str chip: The path to the GPIO chip's character device.
+
+            :Raises:
+                - `OSError` if the GPIO line could not be requested (ie. it is already in use).
+                - `RuntimeError` if the event monitor is running (see `stop_event_monitor()`),
+                  or the previously attached IRQ pin is being waited on by another thread.
+
+            .. seealso:: `set_status_flags()` to configure which events make the IRQ pin active.
+        )docstr",
+             py::arg("pin"), py::arg("chip") = "/dev/gpiochip0")
+
+        // *****************************************************************************
+
+        .def("detach_irq", &RF24Wrapper::detach_irq, R"docstr(
+            detach_irq() -> None
+
+            Release the GPIO line that was requested with `attach_irq()`.
+
+            :raises RuntimeError: if the event monitor is running (see `stop_event_monitor()`),
+                or the IRQ pin is being waited on by another thread (ie. with `wait_irq()`).
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("wait_irq", &RF24Wrapper::wait_irq, R"docstr(
+            wait_irq(timeout_ms: int = -1) -> int
+
+            Wait (with the GIL released) for the radio's IRQ pin to become active, then get and clear the
+            radio's status flags that triggered it. Requires `attach_irq()` to be called first.
+
+            :param int timeout_ms: The maximum number of milliseconds to wait. A negative number
+                (the default) waits forever.
+
+            :Returns: The `rf24_irq_flags_e` flags that caused the event (see `clear_status_flags()`),
+                or ``0`` if the timeout elapsed.
+
+            .. code-block:: python
+
+                radio.attach_irq(24)
+                radio.listen = True
+                while True:
+                    flags = radio.wait_irq(timeout_ms=1000)
+                    if flags & int(RF24_RX_DR):
+                        while radio.available():
+                            print(radio.read())
+        )docstr",
+             py::arg("timeout_ms") = -1)
+
+        // *****************************************************************************
+
+        .def("read_timestamped", &RF24Wrapper::read_timestamped, R"docstr(
+            read_timestamped() -> List[Tuple[int, bytes, int]]
+
+            Fetch all payloads in the RX FIFO with the time that each payload was received.
+
+            If the IRQ pin was attached (see `attach_irq()`), then a payload's timestamp is the kernel's
+            timestamp of the IRQ pin's falling edge that announced it. Edges are paired with payloads
+            only by their order, so this is only done when the number of edges observed matches the
+            number of payloads fetched. Otherwise (ie. a payload arrived while the IRQ pin was already
+            active, or no IRQ pin is attached), the timestamp of every payload in the returned list is
+            taken when this function first reads the radio's STATUS byte.
+
+            :Returns: A `list` of payloads (oldest first), in which each payload is described
+                as a 3-tuple:
+
+                - index 0 is the pipe number that received the payload.
+                - index 1 is the payload (`bytes`).
+                - index 2 is the timestamp (in nanoseconds) of when the payload was received.
+                  This uses the same clock as :py:func:`time.monotonic_ns()`.
+
+            .. code-block:: python
+
+                radio.attach_irq(24)
+                radio.listen = True
+                while True:
+                    if radio.wait_irq(timeout_ms=1000) & int(RF24_RX_DR):
+                        for pipe, payload, timestamp_ns in radio.read_timestamped():
+                            print(f"pipe {pipe} @ {timestamp_ns} ns:", payload)
+
+            .. important::
+                While using this function with an attached IRQ pin, do not use `available()`, `read()`,
+                or similar functions to fetch payloads; the IRQ edges of the payloads they consume would
+                be attributed to other payloads.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("start_event_monitor", &RF24Wrapper::start_event_monitor, R"docstr(
+            start_event_monitor(poll_interval_us: int = 250) -> None
+
+            Start a native background thread that makes `event_fileno` readable when the radio reports an
+            event (data received, data sent, or data failed). This allows event loops (ie. :py:mod:`asyncio`)
+            to wait on the radio without polling it from python; see `aread()` and `awrite()`.
+
+            If the IRQ pin was attached (see `attach_irq()`), then the thread sleeps until the IRQ pin is
+            active. Otherwise, the radio's STATUS byte is polled every ``poll_interval_us`` microseconds.
+            The observed status flags are cleared on the radio and accumulated until they are fetched
+            with `take_events()`.
+
+            :raises RuntimeError: if the event monitor thread is already running.
+
+            .. note::
+                Blocking functions (like `write()`) are not affected by the event monitor because they
+                hold exclusive access to the radio until they return.
+        )docstr",
+             py::arg("poll_interval_us") = 250)
+
+        // *****************************************************************************
+
+        .def("stop_event_monitor", &RF24Wrapper::stop_event_monitor, R"docstr(
+            stop_event_monitor() -> None
+
+            Stop the event monitor thread (if running). The `event_fileno` remains valid.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("event_fileno", &RF24Wrapper::get_event_fileno, R"docstr(
+            This read-only `int` attribute is a file descriptor (an eventfd) that is readable while
+            events observed by the event monitor have not been taken with `take_events()`.
+            This is ``-1`` until `start_event_monitor()` is called.
+
+            .. code-block:: python
+
+                loop.add_reader(radio.event_fileno, callback)
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("take_events", &RF24Wrapper::take_events, R"docstr(
+            take_events(mask: int = RF24_IRQ_ALL.value) -> int
+
+            Fetch (and forget) the events observed by the event monitor thread.
+
+            :param int mask: The `rf24_irq_flags_e` flags to take. Other observed events are kept
+                (and `event_fileno` remains readable).
+
+            :Returns: The `rf24_irq_flags_e` flags (within ``mask``) that were observed.
+        )docstr",
+             py::arg("mask") = RF24_IRQ_ALL)
+
+        // *****************************************************************************
+
+        .def("start_rx_worker", &RF24Wrapper::start_rx_worker, R"docstr(
+            start_rx_worker(capacity: int = 64, poll_interval_us: int = 250, per_pipe: bool = False) -> None
+
+            Start a native background thread that continuously drains the radio's RX FIFO.
+
+            Received payloads are stored in a pre-allocated ring buffer until they are fetched with
+            `rx_worker_pop()`. This prevents the radio's 3-level RX FIFO from overflowing while the
+            python interpreter is busy (ie. garbage collection or slow handlers).
+
+            :param int capacity: The maximum number of received payloads that can be stored
+                before they are dropped. See `rx_worker_dropped`.
+            :param int poll_interval_us: The number of microseconds that the thread sleeps
+                after finding the RX FIFO empty.
+            :param bool per_pipe: Store the payloads of each pipe in a separate ring buffer (of ``capacity``
+                payloads each), so that a busy pipe cannot crowd out the payloads of other pipes.
+                Then `rx_worker_pop()` fetches payloads from the pipes in a weighted round-robin order
+                (see `rx_worker_weights`), and `rx_worker_pop_pipe()` fetches payloads from 1 pipe.
+
+            :raises RuntimeError: if the RX worker thread is already running.
+
+            .. important::
+                The radio should be in RX mode (see `listen`) before starting the RX worker.
+                While the RX worker is running, do not use `available()`, `read()`, or similar
+                functions to fetch payloads; the RX worker will consume them first.
+        )docstr",
+             py::arg("capacity") = 64, py::arg("poll_interval_us") = 250, py::arg("per_pipe") = false)
+
+        // *****************************************************************************
+
+        .def("stop_rx_worker", &RF24Wrapper::stop_rx_worker, R"docstr(
+            stop_rx_worker() -> None
+
+            Stop the RX worker thread (if running). Payloads that were already received can still be fetched
+            with `rx_worker_pop()`.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("rx_worker_pop", &RF24Wrapper::rx_worker_pop, R"docstr(
+            rx_worker_pop(max_count: int) -> List[Tuple[int, bytes, int]]
+
+            Fetch (and remove) up to ``max_count`` payloads received by the RX worker thread.
+
+            :param int max_count: The maximum number of payloads to fetch.
+
+            :Returns: A `list` of payloads (oldest first), in which each payload is described
+                as a 3-tuple:
+
+                - index 0 is the pipe number that received the payload.
+                - index 1 is the payload (`bytes`).
+                - index 2 is the timestamp (in nanoseconds) of when the payload was read from the radio.
+                  This uses the same clock as :py:func:`time.monotonic_ns()`.
+
+            .. code-block:: python
+
+                radio.listen = True
+                radio.start_rx_worker(capacity=128)
+                while True:
+                    for pipe, payload, timestamp in radio.rx_worker_pop(16):
+                        print(f"pipe {pipe} @ {timestamp} ns:", payload)
+        )docstr",
+             py::arg("max_count"))
+
+        // *****************************************************************************
+
+        .def_property_readonly("rx_worker_running", &RF24Wrapper::is_rx_worker_running, R"docstr(
+            This read-only `bool` attribute represents if the RX worker thread is running.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("rx_worker_dropped", &RF24Wrapper::get_rx_worker_dropped, R"docstr(
+            This read-only `int` attribute represents the number of received payloads that were discarded
+            because the RX worker's ring buffer was full. This is reset by `start_rx_worker()`.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("rx_worker_pop_pipe", &RF24Wrapper::rx_worker_pop_pipe, R"docstr(
+            rx_worker_pop_pipe(pipe: int, max_count: int) -> List[Tuple[int, bytes, int]]
+
+            Fetch (and remove) up to ``max_count`` payloads received on a ``pipe`` by the RX worker thread.
+            The returned payloads are described like the result of `rx_worker_pop()`.
+
+            :raises RuntimeError: if the RX worker was not started with ``per_pipe=True``.
+        )docstr",
+             py::arg("pipe"), py::arg("max_count"))
+
+        // *****************************************************************************
+
+        .def_property("rx_worker_weights", &RF24Wrapper::get_rx_worker_weights, &RF24Wrapper::set_rx_worker_weights, R"docstr(
+            This attribute is a 6-tuple of the weights (in range [1, 255]) of each pipe in `rx_worker_pop()`,
+            when the RX worker was started with ``per_pipe=True``. During its turn, a pipe yields up to its weight
+            in payloads before the next pipe (with payloads) takes its turn. Defaults to ``(1, 1, 1, 1, 1, 1)``.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("rx_worker_pending", &RF24Wrapper::get_rx_worker_pending, R"docstr(
+            This read-only attribute is a 6-tuple of the number of payloads (received on each pipe) waiting to be
+            fetched from the RX worker. If the RX worker was started with ``per_pipe=True``, this is the depth of
+            each pipe's ring buffer. Otherwise, the sum of this tuple is the depth of the shared ring buffer.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("rx_worker_pipe_dropped", &RF24Wrapper::get_rx_worker_pipe_dropped, R"docstr(
+            This read-only attribute is a 6-tuple of the number of received payloads that were discarded for each pipe.
+            See `rx_worker_dropped`.
+        )docstr")
+
         // *****************************************************************************
         // ************************** functions that have overloads
 
@@ -881,7 +1617,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("begin", static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::begin), R"docstr(
+        .def("begin", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::begin)), R"docstr(
             begin() -> bool \
             begin(ce_pin: int, csn_pin: int) -> bool
 
@@ -890,7 +1626,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("begin", static_cast<bool (RF24Wrapper::*)(rf24_gpio_pin_t, rf24_gpio_pin_t)>(&RF24Wrapper::begin), R"docstr(
+        .def("begin", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(static_cast<bool (RF24Wrapper::*)(rf24_gpio_pin_t, rf24_gpio_pin_t)>(&RF24Wrapper::begin)), R"docstr(
             If configuring the radio's CE & CSN pins dynamically, then the respective pin numbers must be passed to this function.
 
             :param int ce_pin: The pin number connected to the radio's CE pin.
@@ -902,7 +1638,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("available", static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::available), R"docstr(
+        .def("available", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::available)), R"docstr(
             available() -> bool
 
             Check if there is an available payload in the radio's RX FIFO.
@@ -917,12 +1653,12 @@ void init_rf24(py::module& m)
         // *****************************************************************************
 
         .def("open_rx_pipe", &RF24Wrapper::open_rx_pipe, R"docstr(
-            open_rx_pipe(pipe_number: int, address: Union[bytearray, bytes, int])
+            open_rx_pipe(pipe_number: int, address: Union[Buffer, int])
 
             Open a data pipe for receiving.
 
             :param int pipe_number: The pipe number to use for receiving transmissions. This value should be in range [0, 5].
-            :param bytes,bytearray,int address: The address assigned to the specified data pipe for receiving transmissions.
+            :param Buffer,int address: The address assigned to the specified data pipe for receiving transmissions.
 
                 .. deprecated:: 0.2.1
                     Use `bytes` or `bytearray` to specify the address.
@@ -933,7 +1669,7 @@ void init_rf24(py::module& m)
              py::arg("pipe_number"), py::arg("address"))
 
         .def("openReadingPipe", &RF24Wrapper::open_rx_pipe, R"docstr(
-            openReadingPipe(pipe_number: int, address: Union[bytearray, bytes])
+            openReadingPipe(pipe_number: int, address: Buffer)
         )docstr",
              py::arg("pipe_number"), py::arg("address"))
 
@@ -945,6 +1681,8 @@ void init_rf24(py::module& m)
                 std::string(
                     "Using an integer address is deprecated. "
                     "Specify the address using a buffer protocol (bytes or bytearray) instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.openReadingPipe(pipe_number, address); }, py::arg("pipe_number"), py::arg("address"))
 
         .def(
@@ -953,6 +1691,8 @@ void init_rf24(py::module& m)
                 std::string(
                     "Using an integer address is deprecated. "
                     "Specify the address using a buffer protocol (bytes or bytearray) instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.openReadingPipe(pipe_number, address); }, R"docstr(
             openReadingPipe(pipe_number: int, address: int)
         )docstr",
@@ -961,13 +1701,13 @@ void init_rf24(py::module& m)
         // *****************************************************************************
 
         .def("open_tx_pipe", &RF24Wrapper::open_tx_pipe, R"docstr(
-            open_tx_pipe(address: Union[bytearray, bytes, int])
+            open_tx_pipe(address: Union[Buffer, int])
 
             Open data pipe 0 for transmitting to a specified address.
 
             .. deprecated:: 0.5.0 Use `RF24.stop_listening()` instead.
 
-            :param bytes,bytearray,int address: The address assigned to data pipe 0 for outgoing transmissions.
+            :param Buffer,int address: The address assigned to data pipe 0 for outgoing transmissions.
 
                 .. deprecated:: 0.2.1
                     Use `bytes` or `bytearray` to specify the address.
@@ -978,7 +1718,7 @@ void init_rf24(py::module& m)
              py::arg("address"))
 
         .def("openWritingPipe", &RF24Wrapper::open_tx_pipe, R"docstr(
-            openWritingPipe(address: Union[bytearray, bytes])
+            openWritingPipe(address: Buffer)
         )docstr",
              py::arg("address"))
 
@@ -991,6 +1731,7 @@ void init_rf24(py::module& m)
                     "Using an integer address and `open_tx_pipe()` is deprecated. "
                     "Instead use `stop_listening(address: bytes | bytearray)` "
                     "or `stopListening(address: bytes | bytearray)`"));
+            RadioLock lock(self.spi_mutex);
             return self.openWritingPipe(address); }, py::arg("address"))
 
         .def(
@@ -1000,6 +1741,7 @@ void init_rf24(py::module& m)
                     "Using an integer address and `open_tx_pipe()` is deprecated. "
                     "Instead use `stop_listening(address: bytes | bytearray)` "
                     "or `stopListening(address: bytes | bytearray)`"));
+            RadioLock lock(self.spi_mutex);
             return self.openWritingPipe(address); }, R"docstr(
             openWritingPipe(address: int)
         )docstr",
@@ -1007,14 +1749,14 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("stopListening", static_cast<void (RF24Wrapper::*)(void)>(&RF24Wrapper::stopListening), R"docstr(
+        .def("stopListening", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(static_cast<void (RF24Wrapper::*)(void)>(&RF24Wrapper::stopListening)), R"docstr(
             stopListening() -> None
         )docstr")
 
         // *****************************************************************************
 
-        .def("stop_listening", static_cast<void (RF24Wrapper::*)(void)>(&RF24Wrapper::stopListening), R"docstr(
-            stop_listening(tx_address: Optional[Union[bytes | bytearray | int]] = None) -> None
+        .def("stop_listening", gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(static_cast<void (RF24Wrapper::*)(void)>(&RF24Wrapper::stopListening)), R"docstr(
+            stop_listening(tx_address: Optional[Union[Buffer, int]] = None) -> None
 
             Stop listening for incoming messages, set the TX address, and switch to transmit mode.
 
@@ -1032,7 +1774,7 @@ void init_rf24(py::module& m)
         // *****************************************************************************
 
         .def("stopListening", static_cast<void (RF24Wrapper::*)(py::buffer)>(&RF24Wrapper::stop_listening), R"docstr(
-            stopListening(tx_address: Optional[Union[bytes | bytearray | int]] = None) -> None
+            stopListening(tx_address: Optional[Union[Buffer, int]] = None) -> None
         )docstr",
              py::arg("tx_address"))
 
@@ -1059,6 +1801,8 @@ void init_rf24(py::module& m)
                 std::string(
                     "Using an integer address is deprecated. "
                     "Specify the address using a buffer protocol (bytes or bytearray) instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.stopListening(tx_address); },
             py::arg("tx_address"))
 
@@ -1070,11 +1814,13 @@ void init_rf24(py::module& m)
                 std::string(
                     "Using an integer address is deprecated. "
                     "Specify the address using a buffer protocol (bytes or bytearray) instead."));
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24Wrapper> changed(self);
             return self.stopListening(tx_address); }, py::arg("tx_address"))
 
         // *****************************************************************************
 
-        .def("set_auto_ack", static_cast<void (RF24Wrapper::*)(bool)>(&RF24Wrapper::setAutoAck), R"docstr(
+        .def("set_auto_ack", reconfiguring<RF24Wrapper>(static_cast<void (RF24Wrapper::*)(bool)>(&RF24Wrapper::setAutoAck)), R"docstr(
             set_auto_ack(enable: bool) \
             set_auto_ack(pipe_number: int, enable: bool)
 
@@ -1086,7 +1832,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("enable"))
 
-        .def("setAutoAck", static_cast<void (RF24Wrapper::*)(bool)>(&RF24Wrapper::setAutoAck), R"docstr(
+        .def("setAutoAck", reconfiguring<RF24Wrapper>(static_cast<void (RF24Wrapper::*)(bool)>(&RF24Wrapper::setAutoAck)), R"docstr(
             setAutoAck(enable: bool) \
             setAutoAck(pipe_number: int, enable: bool)
         )docstr",
@@ -1094,13 +1840,13 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("set_auto_ack", static_cast<void (RF24Wrapper::*)(uint8_t, bool)>(&RF24Wrapper::setAutoAck), py::arg("pipe_number"), py::arg("enable"))
+        .def("set_auto_ack", reconfiguring<RF24Wrapper>(static_cast<void (RF24Wrapper::*)(uint8_t, bool)>(&RF24Wrapper::setAutoAck)), py::arg("pipe_number"), py::arg("enable"))
 
-        .def("setAutoAck", static_cast<void (RF24Wrapper::*)(uint8_t, bool)>(&RF24Wrapper::setAutoAck), py::arg("pipe_number"), py::arg("enable"))
+        .def("setAutoAck", reconfiguring<RF24Wrapper>(static_cast<void (RF24Wrapper::*)(uint8_t, bool)>(&RF24Wrapper::setAutoAck)), py::arg("pipe_number"), py::arg("enable"))
 
         // *****************************************************************************
 
-        .def("setPayloadSize", &RF24Wrapper::setPayloadSize, R"docstr(
+        .def("setPayloadSize", spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::setPayloadSize), R"docstr(
             setPayloadSize(length: int)
 
             Configure the radio's static payload size (outgoing and incoming) for all data pipes.
@@ -1111,7 +1857,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("tx_standby", static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::txStandBy), R"docstr(
+        .def("tx_standby", gil_released<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::txStandBy)), R"docstr(
             tx_standby() -> bool \
             tx_standby(timeout: int, start_tx: bool = True) -> bool
 
@@ -1121,13 +1867,13 @@ void init_rf24(py::module& m)
             transmitted or timeout occurs.
         )docstr")
 
-        .def("txStandBy", static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::txStandBy), R"docstr(
+        .def("txStandBy", gil_released<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<bool (RF24Wrapper::*)()>(&RF24Wrapper::txStandBy)), R"docstr(
             txStandBy() -> bool
         )docstr")
 
         // *****************************************************************************
 
-        .def("tx_standby", static_cast<bool (RF24Wrapper::*)(uint32_t, bool)>(&RF24Wrapper::txStandBy), R"docstr(
+        .def("tx_standby", gil_released<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<bool (RF24Wrapper::*)(uint32_t, bool)>(&RF24Wrapper::txStandBy)), R"docstr(
             Optionally, a timeout value can be supplied to augment how long the function will block during transmission.
 
             :param int timeout: The maximum time (in milliseconds) to allow for transmission. This value is added to the
@@ -1136,7 +1882,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("timeout"), py::arg("start_tx") = true)
 
-        .def("txStandBy", static_cast<bool (RF24Wrapper::*)(uint32_t, bool)>(&RF24Wrapper::txStandBy), R"docstr(
+        .def("txStandBy", gil_released<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<bool (RF24Wrapper::*)(uint32_t, bool)>(&RF24Wrapper::txStandBy)), R"docstr(
             txStandBy(timeout: int, start_tx: bool = True) -> bool
         )docstr",
              py::arg("timeout"), py::arg("start_tx") = true)
@@ -1151,6 +1897,7 @@ void init_rf24(py::module& m)
                     "Instead use `is_fifo(about_tx: bool) -> rf24_fifo_state_e`."
                 )
             );
+            RadioLock lock(self.spi_mutex);
             return self.isFifo(about_tx, check_empty); }, R"docstr(
             is_fifo(about_tx: bool, check_empty: bool) -> bool \
             is_fifo(about_tx: bool) -> rf24_fifo_state_e
@@ -1180,6 +1927,7 @@ void init_rf24(py::module& m)
                     "Instead use `isFifo(about_tx: bool) -> rf24_fifo_state_e`."
                 )
             );
+            RadioLock lock(self.spi_mutex);
             return self.isFifo(about_tx, check_empty); }, R"docstr(
             isFifo(about_tx: bool, check_empty: bool) -> bool
         )docstr",
@@ -1187,7 +1935,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def("is_fifo", static_cast<rf24_fifo_state_e (RF24Wrapper::*)(bool)>(&RF24Wrapper::isFifo), R"docstr(
+        .def("is_fifo", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<rf24_fifo_state_e (RF24Wrapper::*)(bool)>(&RF24Wrapper::isFifo)), R"docstr(
             :Returns:
                 - A `bool` describing if the specified FIFO is empty or full
                   if the ``check_empty`` parameter was specified.
@@ -1196,7 +1944,7 @@ void init_rf24(py::module& m)
         )docstr",
              py::arg("about_tx"))
 
-        .def("isFifo", static_cast<rf24_fifo_state_e (RF24Wrapper::*)(bool)>(&RF24Wrapper::isFifo), R"docstr(
+        .def("isFifo", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(static_cast<rf24_fifo_state_e (RF24Wrapper::*)(bool)>(&RF24Wrapper::isFifo)), R"docstr(
             isFifo(about_tx: bool) -> rf24_fifo_state_e
         )docstr",
              py::arg("about_tx"))
@@ -1204,7 +1952,7 @@ void init_rf24(py::module& m)
         // *****************************************************************************
         // *********************************** functions wrapped into python object's properties
 
-        .def_property("channel", &RF24Wrapper::getChannel, &RF24Wrapper::setChannel, R"docstr(
+        .def_property("channel", spi_locked<RF24Wrapper>(&RF24Wrapper::get_channel), reconfiguring<RF24Wrapper>(&RF24Wrapper::setChannel), R"docstr(
             This `int` attribute represents the radio's configured channel (AKA frequency). This roughly translates to frequency (in Hz).
             So, channel 76 (the default setting) is
 
@@ -1213,7 +1961,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("pa_level", &RF24Wrapper::get_pa_level, &RF24Wrapper::set_pa_level, R"docstr(
+        .def_property("pa_level", spi_locked<RF24Wrapper>(&RF24Wrapper::get_pa_level), reconfiguring<RF24Wrapper>(&RF24Wrapper::set_pa_level), R"docstr(
             This attribute represents the radio's configured Power Amplitude level.
 
             .. seealso:: Accepted values are defined in the `rf24_pa_dbm_e` enum struct.
@@ -1221,18 +1969,18 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("payload_size", &RF24Wrapper::getPayloadSize, &RF24Wrapper::setPayloadSize, R"docstr(
+        .def_property("payload_size", &RF24Wrapper::getPayloadSize, spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::setPayloadSize), R"docstr(
             This `int` attribute represents the radio's static payload lengths. Maximum length is 32 bytes; minimum is 1 byte.
 
             .. note:: This attribute is only used when the radio's `dynamic_payloads` feature is disabled
                 (which is disabled by default).
         )docstr")
 
-        .def_property("payloadSize", &RF24Wrapper::getPayloadSize, &RF24Wrapper::setPayloadSize)
+        .def_property("payloadSize", &RF24Wrapper::getPayloadSize, spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::setPayloadSize))
 
         // *****************************************************************************
 
-        .def_property("data_rate", &RF24Wrapper::get_data_rate, &RF24Wrapper::setDataRate, R"docstr(
+        .def_property("data_rate", spi_locked<RF24Wrapper>(&RF24Wrapper::get_data_rate), reconfiguring<RF24Wrapper>(&RF24Wrapper::setDataRate), R"docstr(
             This attribute represents the radio's OTA data rate.
 
             .. hint:: The units "BPS" stand for "Bits Per Second" (not Bytes per second).
@@ -1241,7 +1989,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("crc_length", &RF24Wrapper::getCRCLength, &RF24Wrapper::setCRCLength, R"docstr(
+        .def_property("crc_length", spi_locked<RF24Wrapper>(&RF24Wrapper::get_crc_length), reconfiguring<RF24Wrapper>(&RF24Wrapper::setCRCLength), R"docstr(
             This attribute represents the radio's CRC checksum length (in bits).
 
             .. seealso:: Accepted values are predefined in the `rf24_crclength_e` enum struct.
@@ -1252,14 +2000,14 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("power", &RF24Wrapper::isPowerUp, &RF24Wrapper::power, R"docstr(
+        .def_property("power", spi_locked<RF24Wrapper>(&RF24Wrapper::isPowerUp), gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::power), R"docstr(
             This `bool` attribute represents the radio's power status. `False` means the radio
             is powered down.
         )docstr")
 
         // *****************************************************************************
 
-        .def_property("listen", &RF24Wrapper::isListening, &RF24Wrapper::listen, R"docstr(
+        .def_property("listen", spi_locked<RF24Wrapper>(&RF24Wrapper::isListening), gil_released<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::listen), R"docstr(
             This `bool` attribute represents the radio's primary mode (RX/TX).
 
             .. hint::
@@ -1287,7 +2035,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("dynamic_payloads", &RF24Wrapper::is_dynamic_payloads_enabled, &RF24Wrapper::dynamic_payloads, R"docstr(
+        .def_property("dynamic_payloads", &RF24Wrapper::is_dynamic_payloads_enabled, reconfiguring<RF24Wrapper>(&RF24Wrapper::dynamic_payloads), R"docstr(
             This `bool` attribute represents the radio's dynamic payload length feature for all data pipes.
 
             .. note::
@@ -1297,7 +2045,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("ack_payloads", &RF24Wrapper::is_ack_payloads_enabled, &RF24Wrapper::toggle_ack_payloads, R"docstr(
+        .def_property("ack_payloads", &RF24Wrapper::is_ack_payloads_enabled, reconfiguring<RF24Wrapper>(&RF24Wrapper::toggle_ack_payloads), R"docstr(
             This `bool` attribute represents the status of the radio's acknowledgement payload
             feature for appending data to automatic acknowledgement packets.
 
@@ -1313,7 +2061,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("address_width", &RF24Wrapper::get_address_width, &RF24Wrapper::setAddressWidth, R"docstr(
+        .def_property("address_width", &RF24Wrapper::get_address_width, spi_locked<RF24Wrapper, RadioStats::REGISTER_WRITE>(&RF24Wrapper::setAddressWidth), R"docstr(
             This `int` attribute represents length of addresses used on the radio's data pipes.
             Accepted values range [2, 5].
 
@@ -1350,7 +2098,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property_readonly("rpd", &RF24Wrapper::testRPD, R"docstr(
+        .def_property_readonly("rpd", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::testRPD), R"docstr(
             This read-only `bool` attribute represents if the radio detected a signal above -64 dbm in RX mode.
 
             .. hint::
@@ -1361,7 +2109,7 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property_readonly("rx_fifo_full", &RF24Wrapper::rxFifoFull, R"docstr(
+        .def_property_readonly("rx_fifo_full", spi_locked<RF24Wrapper, RadioStats::STATUS_POLL>(&RF24Wrapper::rxFifoFull), R"docstr(
             This `bool` attribute represents if all 3 levels of the radio's RX FIFO are occupied.
         )docstr")
 
@@ -1373,17 +2121,87 @@ void init_rf24(py::module& m)
 
         // *****************************************************************************
 
-        .def_property_readonly("is_chip_connected", &RF24Wrapper::isChipConnected, R"docstr(
+        .def_property_readonly("is_chip_connected", spi_locked<RF24Wrapper, RadioStats::REGISTER_READ>(&RF24Wrapper::isChipConnected), R"docstr(
             Check if the SPI bus is working with the radio. This read-only `bool` attribute assumes that
             :py:meth:`~pyrf24.RF24.begin()` returned `True`.
         )docstr")
 
-        .def("isChipConnected", &RF24Wrapper::isChipConnected, R"docstr(
+        .def("isChipConnected", spi_locked<RF24Wrapper, RadioStats::REGISTER_READ>(&RF24Wrapper::isChipConnected), R"docstr(
             isChipConnected() -> bool
         )docstr")
 
         // *****************************************************************************
 
+        .def_property("register_shadow", &RF24Wrapper::get_register_shadow, spi_locked<RF24Wrapper>(&RF24Wrapper::set_register_shadow), R"docstr(
+            This `bool` attribute controls the use of a cached copy of the radio's configuration registers
+            (CONFIG, EN_AA, EN_RXADDR, SETUP_RETR, RF_CH, RF_SETUP, DYNPD, and FEATURE). Defaults to `False`.
+
+            When enabled, attributes such as `listen`, `power`, `channel`, `pa_level`, `data_rate`, and
+            `crc_length` are served from memory instead of reading the radio's registers over the SPI bus.
+            The cached registers are forgotten whenever this library changes the radio's configuration,
+            so they are read again only when next needed.
+
+            .. warning::
+                Only enable this if the radio is exclusively configured by this `RF24` object (or
+                the `RF24Network`/`RF24Mesh` objects that use it). If the radio may have been reset
+                (ie. a power loss), then call `resync_registers()`.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("resync_registers", spi_locked<RF24Wrapper>(&RF24Wrapper::resync_registers), R"docstr(
+            resync_registers() -> None
+
+            Refresh the cached registers (see `register_shadow`) by reading them from the radio.
+            This does nothing if `register_shadow` is disabled.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("spi_reads_saved", spi_locked<RF24Wrapper>(&RF24Wrapper::get_spi_reads_saved), R"docstr(
+            This read-only `int` attribute represents the number of SPI transactions that were avoided
+            by using the `register_shadow`. This is reset when `register_shadow` is set.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property("stats_enabled", &RF24Wrapper::get_stats_enabled, spi_locked<RF24Wrapper>(&RF24Wrapper::set_stats_enabled), R"docstr(
+            This `bool` attribute controls the recording of `stats()`. Defaults to `False`.
+
+            While disabled, the overhead of this instrumentation is a single branch per operation.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("stats", spi_locked<RF24Wrapper>(&RF24Wrapper::get_stats), R"docstr(
+            stats() -> dict[str, tuple[int, int, int]]
+
+            Get the number and duration of SPI operations performed on the radio while
+            `stats_enabled` was `True`.
+
+            :Returns: A `dict` whose keys are ``"register_reads"``, ``"register_writes"``,
+                ``"payload_reads"``, ``"payload_writes"``, ``"ce_toggles"``, and ``"status_polls"``.
+                Each value is a `tuple` of 3 `int` items:
+
+                1. The number of operations.
+                2. The total time spent (in nanoseconds), including the time waiting on the
+                   SPI bus.
+                3. The longest time spent on a single call (in nanoseconds).
+
+            .. note::
+                Operations are counted per method call. For example, `write()` counts as 1
+                payload write even though it also polls the radio's STATUS register, and the
+                time spent waiting for an ACK is included in its duration.
+        )docstr")
+
+        .def("reset_stats", spi_locked<RF24Wrapper>(&RF24Wrapper::reset_stats), R"docstr(
+            reset_stats() -> None
+
+            Reset all counters and timings reported by `stats()`.
+        )docstr")
+
+        // *****************************************************************************
+
         .def_readwrite("tx_delay", &RF24Wrapper::txDelay, R"docstr(
             The driver will delay for this duration (`int` in microseconds) when `listen` is set to `False`.
 
@@ -1400,17 +2218,17 @@ void init_rf24(py::module& m)
         .def_readwrite("txDelay", &RF24Wrapper::txDelay)
 
         // *****************************************************************************
-        // **************** functions that accept python's buffer protocol objects (bytes, bytearray)
+        // **************** functions that accept python's buffer protocol objects (ie. bytes, bytearray, memoryview)
 
         .def("start_fast_write", &RF24Wrapper::startFastWrite, R"docstr(
-            start_fast_write(buf: Union[bytearray, bytes], multicast: bool = False, start_tx: bool = True) -> None
+            start_fast_write(buf: Buffer, multicast: bool = False, start_tx: bool = True) -> None
 
             Write a payload to the radio's TX FIFO.
 
             .. seealso::
                 Use `tx_standby()` to ensure the radio has had time to transmit the payload(s) from the TX FIFO.
 
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
             :param bool multicast: Set this parameter to `True` to flag the payload for
                 no acknowledgement. This parameter makes use of the radio's ``NO_ACK`` flag
                 for the individual payload. Defaults to `False`.
@@ -1425,18 +2243,18 @@ void init_rf24(py::module& m)
              py::arg("buf"), py::arg("multicast") = false, py::arg("start_tx") = true)
 
         .def("startFastWrite", &RF24Wrapper::startFastWrite, R"docstr(
-            startFastWrite(buf: Union[bytearray, bytes], multicast: bool = False, start_tx: bool = True) -> None
+            startFastWrite(buf: Buffer, multicast: bool = False, start_tx: bool = True) -> None
         )docstr",
              py::arg("buf"), py::arg("multicast") = false, py::arg("start_tx") = true)
 
         // *****************************************************************************
 
         .def("start_write", &RF24Wrapper::startWrite, R"docstr(
-            start_write(buf: Union[bytearray, bytes], multicast: bool = False) -> bool
+            start_write(buf: Buffer, multicast: bool = False) -> bool
 
             For backward compatibility, this function is similar to `start_fast_write()`.
 
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
             :param bool multicast: Set this parameter to `True` to flag the payload for
                 no acknowledgement. This parameter makes use of the radio's ``NO_ACK`` flag
                 for the individual payload. Defaults to `False`.
@@ -1449,18 +2267,18 @@ void init_rf24(py::module& m)
              py::arg("buf"), py::arg("multicast") = false)
 
         .def("startWrite", &RF24Wrapper::startWrite, R"docstr(
-            startWrite(buf: Union[bytearray, bytes], multicast: bool = False) -> bool
+            startWrite(buf: Buffer, multicast: bool = False) -> bool
         )docstr",
              py::arg("buf"), py::arg("multicast") = false)
 
         // *****************************************************************************
 
         .def("write", &RF24Wrapper::write, R"docstr(
-            write(buf: Union[bytearray, bytes], multicast: bool = False) -> bool
+            write(buf: Buffer, multicast: bool = False) -> bool
 
             Transmit a single payload.
 
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
             :param bool multicast: Set this parameter to `True` to flag the payload for
                 no acknowledgement. This parameter makes use of the radio's ``NO_ACK`` flag
                 for the individual payload. Defaults to `False`.
@@ -1475,34 +2293,174 @@ void init_rf24(py::module& m)
         // *****************************************************************************
 
         .def("write_ack_payload", &RF24Wrapper::writeAckPayload, R"docstr(
-            write_ack_payload(pipe: int, buf: Union[bytearray, bytes]) -> bool
+            write_ack_payload(pipe: int, buf: Buffer) -> bool
 
             Load a payload into the TX FIFO to be used in the ACK packet of automatic acknowledgements.
 
             :param int pipe: The pipe number to use for the acknowledging payload.
 
                 .. seealso:: Set the pipe's assigned address using `open_rx_pipe()`
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
 
             :Returns: `True` if the payload was loaded into the radio's TX FIFO, otherwise `False`.
         )docstr",
              py::arg("pipe"), py::arg("buf"))
 
         .def("writeAckPayload", &RF24Wrapper::writeAckPayload, R"docstr(
-            writeAckPayload(pipe: int, buf: Union[bytearray, bytes]) -> bool
+            writeAckPayload(pipe: int, buf: Buffer) -> bool
         )docstr",
              py::arg("pipe"), py::arg("buf"))
 
         // *****************************************************************************
 
+        .def("enable_link_adaptation", &RF24Wrapper::enable_link_adaptation, R"docstr(
+            enable_link_adaptation(window: int = 32, min_pa_level: rf24_pa_dbm_e = RF24_PA_MIN, max_pa_level: rf24_pa_dbm_e = RF24_PA_MAX, slowest_data_rate: rf24_datarate_e | None = None, fastest_data_rate: rf24_datarate_e | None = None, min_delay: int = 0, max_delay: int = 15, min_count: int = 1, max_count: int = 15) -> None
+
+            Let `write()` tune the auto-retransmit delay and count, the PA level, and the data rate
+            for each destination (TX address) within the given bounds.
+
+            The outcome of every `write()` (with an ACK) is recorded per destination: if it was delivered,
+            the auto-retransmit count (see `get_arc()`), and if `rpd` was asserted before the transmission
+            (by the channel's activity during the last RX session). At the end of each ``window`` of
+            transmissions to the same destination, its settings are adjusted:
+
+            - A lossy link (more than 10% failures, or a mean ARC above half the retry count) is made more
+              robust. If the channel was busy (`rpd` asserted before most transmissions), then the retransmit
+              delay is increased to back off. Otherwise, the PA level is raised, then the data rate is lowered,
+              then the retry count is increased.
+            - After 2 consecutive clean windows (no failures and a mean ARC below 0.25), the data rate is raised,
+              then the PA level is lowered, then the retransmit delay and count are reduced.
+
+            The destination's settings are applied before each `write()`, so that several destinations can be
+            tuned independently. This resets the data of `link_stats()` and `link_decisions()`.
+
+            :param int window: The number of transmissions to a destination between adjustments.
+            :param rf24_pa_dbm_e min_pa_level: The lowest PA level allowed.
+            :param rf24_pa_dbm_e max_pa_level: The highest PA level allowed.
+            :param rf24_datarate_e slowest_data_rate: The slowest data rate allowed. Defaults to the
+                current `data_rate`.
+            :param rf24_datarate_e fastest_data_rate: The fastest data rate allowed. Defaults to the
+                current `data_rate`.
+            :param int min_delay: The shortest auto-retransmit delay allowed (in steps of 250 microseconds,
+                see `set_retries()`).
+            :param int max_delay: The longest auto-retransmit delay allowed. Accepted values range [0, 15].
+            :param int min_count: The fewest auto-retries allowed.
+            :param int max_count: The most auto-retries allowed. Accepted values range [0, 15].
+
+            .. warning::
+                The receiving radio must use the same data rate. Only allow a range of data rates if every
+                destination changes its data rate in the same way (ie. by monitoring the link from its end).
+        )docstr",
+             py::arg("window") = 32, py::arg("min_pa_level") = RF24_PA_MIN, py::arg("max_pa_level") = RF24_PA_MAX,
+             py::arg("slowest_data_rate") = py::none(), py::arg("fastest_data_rate") = py::none(),
+             py::arg("min_delay") = 0, py::arg("max_delay") = 15, py::arg("min_count") = 1, py::arg("max_count") = 15)
+
+        // *****************************************************************************
+
+        .def("disable_link_adaptation", &RF24Wrapper::disable_link_adaptation, R"docstr(
+            disable_link_adaptation() -> None
+
+            Stop tuning the radio's settings in `write()`. The radio keeps its current settings, and the data of
+            `link_stats()` and `link_decisions()` is kept.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("link_adaptation", &RF24Wrapper::is_link_adaptation_enabled, R"docstr(
+            This read-only `bool` attribute represents if link adaptation is enabled.
+            See `enable_link_adaptation()`.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("link_stats", &RF24Wrapper::get_link_stats, R"docstr(
+            link_stats() -> Dict[bytes, Dict[str, Any]]
+
+            Get the state of each destination tracked by link adaptation (up to 16 recently used destinations).
+
+            :Returns: A `dict` in which each key is a destination's 5-byte TX address, and each value is a `dict`:
+
+                - ``"settings"``: a 4-tuple of the destination's auto-retransmit delay, auto-retransmit count,
+                  `rf24_pa_dbm_e`, and `rf24_datarate_e`.
+                - ``"window"``: a 4-tuple describing the transmissions of the window being recorded: the number of
+                  transmissions, failed transmissions, total auto-retransmit count, and transmissions preceded
+                  by an asserted `rpd`.
+                - ``"last_window"``: the same as ``"window"`` for the last completed window.
+                - ``"decisions"``: the number of times the destination's settings were changed.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("link_decisions", &RF24Wrapper::get_link_decisions, R"docstr(
+            link_decisions() -> List[Tuple[int, bytes, str, Tuple[int, int, rf24_pa_dbm_e, rf24_datarate_e], Tuple[int, int, int, int]]]
+
+            Get the most recent (up to 64) changes made by link adaptation (oldest first).
+            Each change is described as a 5-tuple:
+
+            - index 0 is the timestamp (in nanoseconds) of the change.
+              This uses the same clock as :py:func:`time.monotonic_ns()`.
+            - index 1 is the destination's TX address.
+            - index 2 is the reason: ``"raise_pa"``, ``"lower_rate"``, ``"backoff"``, ``"more_retries"``,
+              ``"raise_rate"``, ``"lower_pa"``, ``"shorter_delay"``, or ``"fewer_retries"``.
+            - index 3 is the new settings (see ``"settings"`` in `link_stats()`).
+            - index 4 is the window that triggered the change (see ``"window"`` in `link_stats()`).
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("queue_ack_payloads", &RF24Wrapper::queue_ack_payloads, R"docstr(
+            queue_ack_payloads(pipe: int, payloads: Iterable[Buffer]) -> int
+
+            Queue several ACK payloads for a pipe. The queued payloads are loaded into the radio's TX FIFO
+            natively, as soon as a level of the TX FIFO is available.
+
+            Unlike `write_ack_payload()`, the application does not need to load the next ACK payload after every
+            received payload. The TX FIFO is topped up (balanced between pipes) after every payload is read from
+            the radio (ie. with `read()`, `read_many()`, or the RX worker thread of `start_rx_worker()`), and after
+            every `RF24Network.update()` or `RF24Mesh.update()` (including the updates of the network layer's
+            pump thread, see `RF24Network.start()`).
+
+            :param int pipe: The pipe number to use for the acknowledging payloads. Accepted values range [0, 5].
+            :param Iterable[Buffer] payloads: The payloads to queue (oldest first). Each payload is truncated to 32
+                bytes.
+
+            :Returns: The number of payloads queued. Up to 64 payloads can be queued per pipe; the rest are
+                not queued.
+
+            .. note:: The queued payloads are only loaded while `ack_payloads` is enabled.
+                Use `ack_payloads_queued()` to check how many payloads have not been loaded yet.
+        )docstr",
+             py::arg("pipe"), py::arg("payloads"))
+
+        // *****************************************************************************
+
+        .def("ack_payloads_queued", &RF24Wrapper::get_ack_payloads_queued, R"docstr(
+            ack_payloads_queued(pipe: int) -> int
+
+            The number of ACK payloads queued for a ``pipe`` (with `queue_ack_payloads()`) that were not loaded
+            into the radio's TX FIFO yet.
+        )docstr",
+             py::arg("pipe"))
+
+        // *****************************************************************************
+
+        .def("clear_ack_payloads", &RF24Wrapper::clear_ack_payloads, R"docstr(
+            clear_ack_payloads() -> None
+
+            Discard the ACK payloads queued for all pipes with `queue_ack_payloads()`.
+            ACK payloads that were already loaded remain in the radio's TX FIFO (see `flush_tx()`).
+        )docstr")
+
+        // *****************************************************************************
+
         .def("write_blocking", &RF24Wrapper::writeBlocking, R"docstr(
-            write_blocking(buf: Union[bytearray, bytes], timeout: int) -> bool
+            write_blocking(buf: Buffer, timeout: int) -> bool
 
             A blocking function to load a payload into the radio's TX FIFO. If there is no un-occupied
             level of the TX FIFO, this function waits until a level becomes available or the specified
             timeout is reached.
 
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
             :param int timeout: The amount of time (in milliseconds) to wait while there is no
                 available level in the TX FIFO.
 
@@ -1511,21 +2469,21 @@ void init_rf24(py::module& m)
              py::arg("buf"), py::arg("timeout"))
 
         .def("writeBlocking", &RF24Wrapper::writeBlocking, R"docstr(
-            writeBlocking(buf: Union[bytearray, bytes], timeout: int) -> bool
+            writeBlocking(buf: Buffer, timeout: int) -> bool
         )docstr",
              py::arg("buf"), py::arg("timeout"))
 
         // *****************************************************************************
 
         .def("write_fast", &RF24Wrapper::writeFast, R"docstr(
-            write_fast(buf: Union[bytearray, bytes], multicast: bool = False) -> bool
+            write_fast(buf: Buffer, multicast: bool = False) -> bool
 
             Simply load a payload into the radio's TX FIFO and assert the radio's CE pin to activate transmission.
 
             .. seealso::
                 Use `tx_standby()` to ensure the radio has had time to transmit the payload(s) from the TX FIFO.
 
-            :param bytes,bytearray buf: The payload to load into the TX FIFO.
+            :param Buffer buf: The payload to load into the TX FIFO.
             :param bool multicast: Set this parameter to `True` to flag the payload for
                 no acknowledgement. This parameter makes use of the radio's ``NO_ACK`` flag
                 for the individual payload. Defaults to `False`.
@@ -1538,7 +2496,245 @@ void init_rf24(py::module& m)
              py::arg("buf"), py::arg("multicast") = false)
 
         .def("writeFast", &RF24Wrapper::writeFast, R"docstr(
-            writeFast(buf: Union[bytearray, bytes], multicast: bool = False) -> bool
+            writeFast(buf: Buffer, multicast: bool = False) -> bool
+        )docstr",
+             py::arg("buf"), py::arg("multicast") = false)
+
+        // *****************************************************************************
+
+        .def("write_stream", &RF24Wrapper::write_stream, R"docstr(
+            write_stream(buf: Buffer, payload_size: int, multicast: bool = False, max_retries: int = 100) -> Tuple[int, int, int]
+
+            Stream a contiguous buffer as consecutive payloads while keeping the radio's TX FIFO full.
+
+            This is equivalent to calling `write_fast()` for each payload (handling failed transmissions
+            by clearing the `RF24_TX_DF` flag and pulsing the CE pin), then `tx_standby()`.
+            The entire loop is executed natively with the GIL released.
+
+            :param Buffer buf: The data to transmit. This can be any contiguous object that supports python's
+                buffer protocol (ie. `bytes`, `bytearray` or `memoryview`).
+            :param int payload_size: The length of each payload sliced from ``buf``. Accepted values range
+                [1, 32]. The last payload will be shorter if ``buf`` is not a multiple of this length.
+            :param bool multicast: Set this parameter to `True` to flag the payloads for
+                no acknowledgement. See `write()` for more detail. Defaults to `False`.
+            :param int max_retries: The maximum number of failed transmissions to re-attempt before
+                aborting the stream. Defaults to 100.
+
+            :Returns: A 3-tuple in which
+
+                - index 0 is the number of payloads uploaded to the TX FIFO.
+                - index 1 is the number of failed transmissions detected (and re-attempted).
+                - index 2 is the total time spent (in microseconds).
+
+            .. note:: If the number of failures exceeds ``max_retries``, then the TX FIFO is flushed.
+                In this case, up to 3 of the counted payloads (in index 0) were not transmitted.
+        )docstr",
+             py::arg("buf"), py::arg("payload_size"), py::arg("multicast") = false, py::arg("max_retries") = 100)
+
+        // *****************************************************************************
+
+        .def("scan", &RF24Wrapper::scan, R"docstr(
+            scan(channels: Iterable[int], dwell_us: int = 130, passes: int = 1, out: Buffer | None = None, callback: Callable[[int, bytes], bool | None] | None = None) -> Buffer
+
+            Sweep the given channels for ambient signals using the radio's Received Power Detector (RPD).
+
+            For each channel, the radio listens for ``dwell_us`` microseconds before `rpd` is sampled.
+            Then, any payload captured in the RX FIFO is counted as a detected packet (and flushed).
+            Each pass is executed natively with the GIL released, so the dwell times are not skewed by
+            python's overhead. The radio's `channel` and RX/TX mode are restored after each pass.
+            Other threads may use the radio between channels (not during a channel's dwell time).
+
+            :param Iterable[int] channels: The channels to sweep (in order). Accepted values range [0, 125].
+            :param int dwell_us: The time (in microseconds) to listen on each channel, including the
+                radio's RX settling time of 130 microseconds. Defaults to 130.
+            :param int passes: The number of sweeps through all ``channels``. Defaults to 1.
+            :param Buffer out: A writable buffer that holds 2 native unsigned 32-bit counts per channel
+                (ie. an ``array.array("I")``): the number of RPD detections and the number of detected
+                packets. The counts of each pass are added to the existing values, so the same buffer can
+                accumulate a histogram over several calls. Defaults to a new zero-filled
+                ``array.array("I")``.
+            :param Callable callback: An optional function called after each pass with the pass number
+                and a `bytes` object of 1 byte per channel, in which bit 0 is set for an RPD detection and
+                bit 1 is set for a detected packet. The scan stops early if this function returns `False`.
+
+            :Returns: The ``out`` buffer.
+
+            .. seealso:: The :doc:`examples` contain a scanner using this function.
+        )docstr",
+             py::arg("channels"), py::arg("dwell_us") = 130, py::arg("passes") = 1, py::arg("out") = py::none(), py::arg("callback") = py::none());
+
+#if defined(RF24_SIMULATED)
+    // ********************** Simulated RF environment (only with the SIMULATED driver)
+    typedef rf24_sim::Medium Medium;
+    typedef std::lock_guard<std::mutex> MediumLock;
+
+    py::class_<Medium, std::unique_ptr<Medium, py::nodelete>>(m, "SimulatedMedium", R"docstr(
+        The RF environment shared by all simulated radios in this process.
+        Only available when the pyrf24 package is built with the ``SIMULATED`` `RF24_DRIVER`.
+        Use the `simulated_medium` instance of this class.
+
+        A frame is received if the receiving radio is listening on the same channel with the same
+        data rate, address, CRC, and payload configuration, and
+
+        - the frame did not overlap another frame on the same channel (a collision),
+        - the received power (the transmitter's PA level minus the `path_loss`) meets the
+          receiver's sensitivity,
+        - and the frame was not randomly dropped (see `packet_loss`).
+
+        The same rules apply to ACK packets (in the reverse direction).
+
+        The simulation uses a virtual clock (see `time_us`) instead of the host's clock: each SPI
+        transaction advances it by the transaction's duration, and the RF24 stack's delays advance it
+        instead of sleeping. So, the timing of a scenario only depends on its sequence of radio
+        operations, not on the host's speed or scheduling.
+    )docstr")
+
+        .def_property(
+            "packet_loss",
+            [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return self.packet_loss;
+            },
+            [](Medium& self, double probability) {
+                if (probability < 0.0 || probability > 1.0)
+                    throw py::value_error("packet_loss must be in range [0, 1]");
+                MediumLock lock(self.mutex);
+                self.packet_loss = probability;
+            },
+            R"docstr(
+            The probability (a `float` in range [0, 1]) that any frame is lost. Defaults to ``0.0``.
+        )docstr")
+
+        .def_property(
+            "path_loss",
+            [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return self.path_loss;
+            },
+            [](Medium& self, double attenuation) {
+                MediumLock lock(self.mutex);
+                self.path_loss = attenuation;
+            },
+            R"docstr(
+            The attenuation (a `float` in dB) between any 2 radios. Defaults to ``40.0``.
+
+            The received power also determines the `RF24.rpd` attribute (asserted at -64 dBm or more).
+        )docstr")
+
+        .def_property(
+            "latency",
+            [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return static_cast<uint32_t>(self.latency / 1000);
+            },
+            [](Medium& self, uint32_t delay) {
+                MediumLock lock(self.mutex);
+                self.latency = static_cast<uint64_t>(delay) * 1000;
+            },
+            R"docstr(
+            An extra delay (an `int` in microseconds) added to the air time of every frame. Defaults to ``0``.
+        )docstr")
+
+        .def(
+            "seed", [](Medium& self, uint32_t value) {
+                MediumLock lock(self.mutex);
+                self.seed(value);
+            },
+            R"docstr(
+            seed(value: int) -> None
+
+            Restart the random number generator used for `packet_loss`, so a scenario can be repeated.
+
+            Because the air time, auto-retry delays, collisions, and `latency` follow the virtual clock
+            (see `time_us`), a scenario that drives the radios from 1 thread produces the same trace on
+            every run with the same seed. With several threads, the order of their radio operations
+            (and so the trace) depends on how the threads are scheduled.
+        )docstr",
+            py::arg("value"))
+
+        .def(
+            "set_link", [](Medium& self, int transmitter, int receiver, double packet_loss, double path_loss) {
+                if (packet_loss < 0.0 || packet_loss > 1.0)
+                    throw py::value_error("packet_loss must be in range [0, 1]");
+                MediumLock lock(self.mutex);
+                self.set_link(transmitter, receiver, packet_loss, path_loss);
+            },
+            R"docstr(
+            set_link(transmitter: int, receiver: int, packet_loss: float, path_loss: float) -> None
+
+            Override the `packet_loss` and `path_loss` for 1 direction between 2 radios.
+
+            :param int transmitter: The CSN pin number of the transmitting radio.
+            :param int receiver: The CSN pin number of the receiving radio.
+            :param float packet_loss: The probability (in range [0, 1]) that a frame is lost.
+            :param float path_loss: The attenuation (in dB) between the radios.
+        )docstr",
+            py::arg("transmitter"), py::arg("receiver"), py::arg("packet_loss"), py::arg("path_loss"))
+
+        .def(
+            "clear_links", [](Medium& self) {
+                MediumLock lock(self.mutex);
+                self.clear_links();
+            },
+            R"docstr(
+            clear_links() -> None
+
+            Forget all links configured with `set_link()`.
+        )docstr")
+
+        .def_property_readonly(
+            "time_us", [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return self.now() / 1000;
+            },
+            R"docstr(
+            The time (an `int` in microseconds) of the virtual clock that drives the simulation.
+        )docstr")
+
+        .def(
+            "advance", [](Medium& self, uint32_t duration_us) {
+                MediumLock lock(self.mutex);
+                self.elapse(static_cast<uint64_t>(duration_us) * 1000);
+            },
+            R"docstr(
+            advance(duration_us: int) -> None
+
+            Advance the virtual clock (see `time_us`) by ``duration_us`` microseconds, processing all
+            transmissions scheduled until then. Use this instead of :py:func:`time.sleep()` to let
+            simulated time pass (ie. to wait for a transmission to finish).
         )docstr",
-             py::arg("buf"), py::arg("multicast") = false);
+            py::arg("duration_us"))
+
+        .def_property_readonly(
+            "collisions", [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return self.collisions;
+            },
+            R"docstr(
+            The number (`int`) of frames corrupted by overlapping transmissions.
+        )docstr")
+
+        .def_property_readonly(
+            "lost_frames", [](Medium& self) {
+                MediumLock lock(self.mutex);
+                return self.lost_frames;
+            },
+            R"docstr(
+            The number (`int`) of frames dropped by `packet_loss`.
+        )docstr")
+
+        .def(
+            "reset_counters", [](Medium& self) {
+                MediumLock lock(self.mutex);
+                self.collisions = 0;
+                self.lost_frames = 0;
+            },
+            R"docstr(
+            reset_counters() -> None
+
+            Reset the `collisions` and `lost_frames` counters.
+        )docstr");
+
+    m.attr("simulated_medium") = py::cast(&Medium::instance(), py::return_value_policy::reference);
+#endif
 }
@@ -3,16 +3,535 @@
 #include <pybind11/pybind11.h>
 #include <RF24.h>
 #include <nRF24L01.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pyLinkAdapter.h"
 using namespace nRF24L01;
 
 namespace py = pybind11;
 
-void throw_ba_exception(void);
-char* get_bytes_or_bytearray_str(py::object buf);
-int get_bytes_or_bytearray_ln(py::object buf);
 void init_rf24(py::module& m);
 void emit_deprecation_warning(std::string message);
 
+/**
+ * The current CLOCK_MONOTONIC time (in nanoseconds), the same clock as python's ``time.monotonic_ns()``.
+ * Every timestamp given to python (ie. by the RX worker or read_timestamped()) uses this.
+ */
+inline uint64_t monotonic_ns()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * A contiguous view of a python object that supports the buffer protocol.
+ *
+ * Unlike ``py::buffer_info``, this does not allocate anything on the heap.
+ * The exported buffer is released when this object is destroyed, and the exporting object
+ * (ie. a `bytearray`) cannot be resized while this view exists.
+ */
+class BufferView
+{
+public:
+    BufferView(py::handle obj, bool writable)
+    {
+        if (PyObject_GetBuffer(obj.ptr(), &view, writable ? PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE : PyBUF_C_CONTIGUOUS) != 0)
+            throw py::error_already_set();
+    }
+
+    BufferView(const BufferView&) = delete;
+    BufferView& operator=(const BufferView&) = delete;
+
+    ~BufferView()
+    {
+        PyBuffer_Release(&view);
+    }
+
+    uint8_t* data()
+    {
+        return static_cast<uint8_t*>(view.buf);
+    }
+
+    Py_ssize_t size() const
+    {
+        return view.len;
+    }
+
+private:
+    Py_buffer view;
+};
+
+/**
+ * Hold a radio's SPI mutex for the current scope.
+ *
+ * The mutex is first acquired without blocking. If another thread holds it (ie. during a
+ * transmission that released the GIL), then the GIL is released while waiting for it.
+ * This must only be used from a thread that holds the GIL.
+ */
+class RadioLock
+{
+public:
+    explicit RadioLock(std::mutex& mutex) : lock(mutex, std::try_to_lock)
+    {
+        if (!lock.owns_lock()) {
+            py::gil_scoped_release release;
+            lock.lock();
+        }
+    }
+
+private:
+    std::unique_lock<std::mutex> lock;
+};
+
+/**
+ * Invalidate a wrapper's cached copy of the radio's registers when this goes out of scope.
+ * The radio's SPI mutex must be held for this object's entire lifetime.
+ *
+ * The ``Wrapper`` type must have an ``invalidate_registers()`` method.
+ */
+template<typename Wrapper>
+class RegistersChanged
+{
+public:
+    explicit RegistersChanged(Wrapper& _wrapper) : wrapper(_wrapper)
+    {
+    }
+
+    ~RegistersChanged()
+    {
+        wrapper.invalidate_registers();
+    }
+
+private:
+    Wrapper& wrapper;
+};
+
+/**
+ * Opt-in counters and timings of the operations performed on a radio.
+ * All members are guarded by the radio's SPI mutex.
+ */
+class RadioStats
+{
+public:
+    enum Operation
+    {
+        REGISTER_READ,
+        REGISTER_WRITE,
+        PAYLOAD_READ,
+        PAYLOAD_WRITE,
+        CE_TOGGLE,
+        STATUS_POLL,
+        OPERATIONS,
+        /** Used to not record an operation. */
+        UNRECORDED = -1,
+    };
+
+    struct Counter
+    {
+        uint64_t count;
+        uint64_t total_ns;
+        uint64_t max_ns;
+    };
+
+    RadioStats() : enabled(false)
+    {
+        reset();
+    }
+
+    bool enabled;
+    Counter counters[OPERATIONS];
+
+    void reset()
+    {
+        memset(counters, 0, sizeof(counters));
+    }
+
+    /** The name of an ``operation`` as exposed to python. */
+    static const char* name(int operation)
+    {
+        static const char* names[OPERATIONS] = {
+            "register_reads", "register_writes", "payload_reads", "payload_writes", "ce_toggles", "status_polls"};
+        return names[operation];
+    }
+
+    /**
+     * Record the duration of an operation for the current scope (if the stats are enabled).
+     * The ``operation`` and ``count`` can be changed before this goes out of scope.
+     */
+    class Timer
+    {
+    public:
+        Timer(RadioStats& _stats, int _operation) : operation(_operation), count(1), stats(_stats.enabled ? &_stats : nullptr)
+        {
+            if (stats)
+                start = std::chrono::steady_clock::now();
+        }
+
+        ~Timer()
+        {
+            if (!stats || operation == UNRECORDED)
+                return;
+            uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                         std::chrono::steady_clock::now() - start)
+                                                         .count());
+            Counter& counter = stats->counters[operation];
+            counter.count += count;
+            counter.total_ns += elapsed;
+            if (elapsed > counter.max_ns)
+                counter.max_ns = elapsed;
+        }
+
+        int operation;
+        uint32_t count;
+
+    private:
+        RadioStats* stats;
+        std::chrono::steady_clock::time_point start;
+    };
+};
+
+/**
+ * Record an ``Operation`` (see RadioStats) in a wrapper's stats for the current scope.
+ * The ``Wrapper`` type must have a ``stats`` member, unless ``Operation`` is ``RadioStats::UNRECORDED``.
+ */
+template<typename Wrapper, int Operation>
+class ScopedStat : public RadioStats::Timer
+{
+public:
+    explicit ScopedStat(Wrapper& wrapper) : RadioStats::Timer(wrapper.stats, Operation)
+    {
+    }
+};
+
+template<typename Wrapper>
+class ScopedStat<Wrapper, RadioStats::UNRECORDED>
+{
+public:
+    explicit ScopedStat(Wrapper&)
+    {
+    }
+};
+
+/**
+ * Bind a method that is called while holding the radio's SPI mutex.
+ * Use this for short SPI transactions that do not need to release the GIL.
+ * The optional ``Operation`` is recorded in the wrapper's RadioStats.
+ *
+ * The ``Wrapper`` type must have a ``spi_mutex`` member.
+ */
+template<typename Wrapper, int Operation = RadioStats::UNRECORDED, typename Return, typename Class, typename... Args>
+std::function<Return(Wrapper&, Args...)> spi_locked(Return (Class::*method)(Args...))
+{
+    return [method](Wrapper& self, Args... args) -> Return {
+        RadioLock lock(self.spi_mutex);
+        ScopedStat<Wrapper, Operation> stat(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+template<typename Wrapper, int Operation = RadioStats::UNRECORDED, typename Return, typename Class, typename... Args>
+std::function<Return(Wrapper&, Args...)> spi_locked(Return (Class::*method)(Args...) const)
+{
+    return [method](Wrapper& self, Args... args) -> Return {
+        RadioLock lock(self.spi_mutex);
+        ScopedStat<Wrapper, Operation> stat(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+/**
+ * Bind a method that changes the radio's configuration while holding the radio's SPI mutex.
+ * This is like spi_locked(), but the wrapper's cached registers are invalidated afterward.
+ *
+ * The ``Wrapper`` type must have a ``spi_mutex`` member, a ``stats`` member,
+ * and an ``invalidate_registers()`` method.
+ */
+template<typename Wrapper, int Operation = RadioStats::REGISTER_WRITE, typename Return, typename Class, typename... Args>
+std::function<Return(Wrapper&, Args...)> reconfiguring(Return (Class::*method)(Args...))
+{
+    return [method](Wrapper& self, Args... args) -> Return {
+        RadioLock lock(self.spi_mutex);
+        RegistersChanged<Wrapper> changed(self);
+        ScopedStat<Wrapper, Operation> stat(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+/**
+ * Bind a method that releases the GIL and then holds the radio's SPI mutex.
+ * Use this for functions that block on SPI, CE timing, or auto-retry delays.
+ * These are mostly state transitions, so the wrapper's cached registers are invalidated afterward.
+ * The optional ``Operation`` is recorded in the wrapper's RadioStats.
+ *
+ * The ``Wrapper`` type must have a ``spi_mutex`` member and an ``invalidate_registers()`` method.
+ */
+template<typename Wrapper, int Operation = RadioStats::UNRECORDED, typename Return, typename Class, typename... Args>
+std::function<Return(Wrapper&, Args...)> gil_released(Return (Class::*method)(Args...))
+{
+    return [method](Wrapper& self, Args... args) -> Return {
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(self.spi_mutex);
+        RegistersChanged<Wrapper> changed(self);
+        ScopedStat<Wrapper, Operation> stat(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+template<typename Wrapper, int Operation = RadioStats::UNRECORDED, typename Return, typename Class, typename... Args>
+std::function<Return(Wrapper&, Args...)> gil_released(Return (Class::*method)(Args...) const)
+{
+    return [method](Wrapper& self, Args... args) -> Return {
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(self.spi_mutex);
+        RegistersChanged<Wrapper> changed(self);
+        ScopedStat<Wrapper, Operation> stat(self);
+        return (self.*method)(std::forward<Args>(args)...);
+    };
+}
+
+/**
+ * The radio's IRQ pin requested as an input line (with falling edge detection)
+ * using the Linux GPIO character device (v2 uAPI).
+ */
+class IrqPin
+{
+public:
+    /** The maximum number of edge timestamps kept (the depth of the radio's RX FIFO). */
+    static const uint8_t EDGES = 3;
+
+    IrqPin() : fd(-1), users(0), edge_count(0)
+    {
+    }
+
+    IrqPin(const IrqPin&) = delete;
+    IrqPin& operator=(const IrqPin&) = delete;
+
+    ~IrqPin()
+    {
+        close_line();
+    }
+
+    /**
+     * Request the ``pin`` offset from the GPIO ``chip``. Raises OSError on failure (requires the GIL),
+     * or RuntimeError if the previously requested line is in use (see wait() and take_edges()).
+     */
+    void request(const std::string& chip, uint32_t pin);
+
+    /** Release the requested line (if any). Raises RuntimeError if the line is in use. */
+    void release();
+
+    bool is_requested()
+    {
+        std::lock_guard<std::mutex> lock(fd_mutex);
+        return fd >= 0;
+    }
+
+    /**
+     * Block until the IRQ pin is active (LOW) or ``timeout_ms`` has elapsed (negative means forever).
+     * Does not use the GIL. Returns 1 if the pin is active, 0 on timeout, or ``-errno`` on failure
+     * (``-EBADF`` if no line is requested).
+     */
+    int wait(int timeout_ms);
+
+    /**
+     * Move the kernel timestamps (CLOCK_MONOTONIC nanoseconds) of the falling edges observed since the
+     * last call into ``timestamps`` (oldest first). Queued edge events are read without blocking.
+     * Returns the number of timestamps copied (up to EDGES).
+     */
+    uint8_t take_edges(uint64_t* timestamps);
+
+private:
+    /**
+     * Keeps the requested line's file descriptor open for the current scope (release() and request()
+     * refuse to close it meanwhile). ``fd`` is negative if no line is requested.
+     */
+    class LineUse
+    {
+    public:
+        explicit LineUse(IrqPin& _pin) : pin(_pin)
+        {
+            std::lock_guard<std::mutex> lock(pin.fd_mutex);
+            fd = pin.fd;
+            if (fd >= 0)
+                ++pin.users;
+        }
+
+        ~LineUse()
+        {
+            if (fd >= 0) {
+                std::lock_guard<std::mutex> lock(pin.fd_mutex);
+                --pin.users;
+            }
+        }
+
+        int fd;
+
+    private:
+        IrqPin& pin;
+    };
+
+    /** Record the timestamps of the edge events queued on ``line`` (without blocking). */
+    void read_events(int line);
+
+    /** Close the requested line (if any). fd_mutex must be held, and the line must not be in use. */
+    void close_line();
+
+    /** The file descriptor of the requested line. */
+    int fd;
+    /** Guards fd and users. */
+    std::mutex fd_mutex;
+    /** The number of LineUse objects that hold fd open. */
+    uint32_t users;
+    /** Guards the edge timestamps (wait() and take_edges() may be called from different threads). */
+    std::mutex edges_mutex;
+    uint64_t edges[EDGES];
+    uint8_t edge_count;
+};
+
+/**
+ * A preallocated FIFO queue of ``capacity`` items that is guarded by a mutex,
+ * so that any number of threads can push and pop items.
+ */
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity) : slots(capacity), head(0), count(0)
+    {
+    }
+
+    /** Append a copy of ``item``. Returns false (without appending) if the queue is full. */
+    bool push(const T& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == slots.size())
+            return false;
+        slots[(head + count) % slots.size()] = item;
+        ++count;
+        return true;
+    }
+
+    /** Move the oldest item into ``item``. Returns false if the queue is empty. */
+    bool pop(T& item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!count)
+            return false;
+        item = slots[head];
+        head = (head + 1) % slots.size();
+        --count;
+        return true;
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        head = 0;
+        count = 0;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+};
+
+/** An ACK payload queued for 1 pipe (see RF24Wrapper::queue_ack_payloads()). */
+struct AckPayload
+{
+    uint8_t length;
+    uint8_t payload[32];
+};
+
+/** A payload received by the RX worker thread (see RF24Wrapper::start_rx_worker()). */
+struct RxRecord
+{
+    /** monotonic_ns() of when the payload was read from the radio (or received, see read_timestamped()). */
+    uint64_t timestamp;
+    uint8_t pipe;
+    uint8_t length;
+    uint8_t payload[32];
+};
+
+/**
+ * A preallocated lock-free ring buffer with exactly one producer thread and one consumer thread.
+ *
+ * One slot is always left unused to distinguish a full ring from an empty ring.
+ */
+class RxRing
+{
+public:
+    explicit RxRing(size_t capacity) : slots(capacity + 1), head(0), tail(0)
+    {
+    }
+
+    /** Producer: get the next free slot, or nullptr if the ring is full. */
+    RxRecord* claim()
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if ((h + 1) % slots.size() == tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots[h];
+    }
+
+    /** Producer: make the slot returned by claim() visible to the consumer. */
+    void publish()
+    {
+        head.store((head.load(std::memory_order_relaxed) + 1) % slots.size(), std::memory_order_release);
+    }
+
+    /** Consumer: get the oldest record, or nullptr if the ring is empty. */
+    const RxRecord* front()
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots[t];
+    }
+
+    /** Consumer: release the record returned by front() back to the producer. */
+    void pop()
+    {
+        tail.store((tail.load(std::memory_order_relaxed) + 1) % slots.size(), std::memory_order_release);
+    }
+
+    /** Consumer: the number of records that can be fetched with front(). */
+    size_t size()
+    {
+        return (head.load(std::memory_order_acquire) + slots.size() - tail.load(std::memory_order_relaxed)) % slots.size();
+    }
+
+    /** Consumer: add the number of records (that can be fetched with front()) of each pipe to ``counts``. */
+    void count_pipes(size_t* counts)
+    {
+        size_t h = head.load(std::memory_order_acquire);
+        for (size_t t = tail.load(std::memory_order_relaxed); t != h; t = (t + 1) % slots.size())
+            ++counts[slots[t].pipe % 6];
+    }
+
+private:
+    std::vector<RxRecord> slots;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+};
+
 class RF24Wrapper : public RF24
 {
 
@@ -26,7 +545,24 @@ public:
     }
 
     // needed for polymorphic recognition
-    virtual ~RF24Wrapper() = default;
+    virtual ~RF24Wrapper()
+    {
+        join_rx_worker();
+        join_event_monitor();
+        close_event_fd();
+    }
+
+    /** Serializes all SPI transactions (and CE toggles) on this radio across threads. */
+    std::mutex spi_mutex;
+
+    /** Opt-in counters & timings of the SPI operations performed on this radio (guarded by spi_mutex). */
+    RadioStats stats;
+
+    /** The length of the next payload in the RX FIFO (0 if it was flushed as corrupt). The SPI mutex must be held. */
+    uint8_t rx_payload_length()
+    {
+        return RF24::dynamic_payloads_enabled ? RF24::getDynamicPayloadSize() : RF24::getPayloadSize();
+    }
 
     std::tuple<bool, uint8_t> available_pipe()
     {
@@ -53,86 +589,648 @@ public:
                 "`open_tx_pipe()` (and `openWritingPipe()`) is deprecated. "
                 "Instead use `stop_listening(address: bytes | bytearray)` "
                 "or `stopListening(address: bytes | bytearray)`."));
-        RF24::openWritingPipe(reinterpret_cast<uint8_t*>(get_bytes_or_bytearray_str(address)));
+        BufferView view(address, false);
+        uint8_t padded[5];
+        RadioLock lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::REGISTER_WRITE);
+        RF24::openWritingPipe(address_of(view, padded));
     }
 
     void stop_listening(py::buffer address)
     {
-        RF24::stopListening(reinterpret_cast<uint8_t*>(get_bytes_or_bytearray_str(address)));
+        BufferView view(address, false);
+        uint8_t padded[5];
+        const uint8_t* tx_address = address_of(view, padded);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24Wrapper> changed(*this);
+        RadioStats::Timer timer(stats, RadioStats::REGISTER_WRITE);
+        RF24::stopListening(tx_address);
     }
 
     void open_rx_pipe(uint8_t number, py::buffer address)
     {
-        RF24::openReadingPipe(number, reinterpret_cast<uint8_t*>(get_bytes_or_bytearray_str(address)));
+        BufferView view(address, false);
+        uint8_t padded[5];
+        RadioLock lock(spi_mutex);
+        RegistersChanged<RF24Wrapper> changed(*this);
+        RadioStats::Timer timer(stats, RadioStats::REGISTER_WRITE);
+        RF24::openReadingPipe(number, address_of(view, padded));
     }
 
     py::bytearray read(uint8_t length = 0)
     {
-        if (!length)
-            length = RF24::dynamic_payloads_enabled ? RF24::getDynamicPayloadSize() : RF24::getPayloadSize();
-        else
-            length = rf24_min(length, static_cast<uint8_t>(32));
-        char* payload = new char[length + 1];
-        RF24::read(payload, length);
-        payload[length] = '\0';
-        py::bytearray buf = py::bytearray(payload, length);
-        delete[] payload;
-        return buf;
+        // the bytearray is created after unlocking spi_mutex (allocating may run python code)
+        char payload[32];
+        {
+            RadioLock lock(spi_mutex);
+            RadioStats::Timer timer(stats, RadioStats::PAYLOAD_READ);
+            if (!length)
+                length = rx_payload_length();
+            else
+                length = rf24_min(length, static_cast<uint8_t>(32));
+            RF24::read(payload, length);
+            refill_ack_payloads();
+        }
+        return py::bytearray(payload, length);
+    }
+
+    uint8_t read_into(py::buffer buf, Py_ssize_t offset = 0)
+    {
+        BufferView view(buf, true);
+        if (offset < 0 || offset > view.size())
+            throw py::index_error("offset is out of the buffer's range");
+        RadioLock lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_READ);
+        uint8_t length = rx_payload_length();
+        if (view.size() - offset < length)
+            throw py::value_error("buffer is too small for the next available payload");
+        RF24::read(view.data() + offset, length);
+        refill_ack_payloads();
+        return length;
+    }
+
+    py::bytes read_many(uint8_t max_count, py::buffer buf)
+    {
+        BufferView view(buf, true);
+        uint8_t meta[255 * 2];
+        uint8_t count = 0;
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(spi_mutex);
+            RadioStats::Timer timer(stats, RadioStats::PAYLOAD_READ);
+            Py_ssize_t offset = 0;
+            uint8_t pipe = 7;
+            while (count < max_count && RF24::available(&pipe)) {
+                uint8_t length = rx_payload_length();
+                if (!length || view.size() - offset < length)
+                    break; // RX FIFO was flushed (corrupted payload) or buffer is full
+                RF24::read(view.data() + offset, length);
+                offset += length;
+                meta[count * 2] = pipe;
+                meta[count * 2 + 1] = length;
+                ++count;
+            }
+            refill_ack_payloads();
+            timer.count = count;
+        }
+        return py::bytes(reinterpret_cast<char*>(meta), count * 2);
+    }
+
+    void start_rx_worker(size_t capacity = 64, uint32_t poll_interval_us = 250, bool per_pipe = false)
+    {
+        if (!capacity)
+            throw py::value_error("capacity must be greater than 0");
+        RadioLock consumer(rx_worker_mutex);
+        if (rx_worker_running.load())
+            throw std::runtime_error("the RX worker thread is already running");
+        rx_ring.reset(per_pipe ? nullptr : new RxRing(capacity));
+        for (uint8_t i = 0; i < 6; ++i) {
+            pipe_rings[i].reset(per_pipe ? new RxRing(capacity) : nullptr);
+            rx_worker_pipe_dropped[i].store(0);
+        }
+        next_pipe = 0;
+        pipe_credit = pipe_weights[0];
+        rx_worker_dropped.store(0);
+        rx_worker_running.store(true);
+        rx_worker = std::thread(&RF24Wrapper::rx_worker_loop, this, std::chrono::microseconds(poll_interval_us));
+    }
+
+    void stop_rx_worker()
+    {
+        RadioLock consumer(rx_worker_mutex);
+        py::gil_scoped_release release;
+        join_rx_worker();
     }
 
+    py::list rx_worker_pop(size_t max_count)
+    {
+        RadioLock consumer(rx_worker_mutex);
+        py::list records;
+        if (rx_ring) {
+            while (records.size() < max_count && pop_record(*rx_ring, records)) {
+            }
+            return records;
+        }
+        if (!pipe_rings[0])
+            return records;
+        // weighted round-robin: up to pipe_weights[pipe] records per pipe in turn
+        uint8_t idle_turns = 0;
+        while (records.size() < max_count && idle_turns <= 6) {
+            if (pipe_credit && pop_record(*pipe_rings[next_pipe], records)) {
+                --pipe_credit;
+                idle_turns = 0;
+                continue;
+            }
+            next_pipe = (next_pipe + 1) % 6;
+            pipe_credit = pipe_weights[next_pipe];
+            ++idle_turns;
+        }
+        return records;
+    }
+
+    py::list rx_worker_pop_pipe(uint8_t pipe, size_t max_count)
+    {
+        if (pipe > 5)
+            throw py::value_error("pipe must be in range [0, 5]");
+        RadioLock consumer(rx_worker_mutex);
+        if (rx_ring)
+            throw std::runtime_error("the RX worker was not started with per_pipe=True");
+        py::list records;
+        if (!pipe_rings[pipe])
+            return records;
+        while (records.size() < max_count && pop_record(*pipe_rings[pipe], records)) {
+        }
+        return records;
+    }
+
+    py::tuple get_rx_worker_pending()
+    {
+        size_t counts[6] = {0};
+        {
+            RadioLock consumer(rx_worker_mutex);
+            if (rx_ring)
+                rx_ring->count_pipes(counts);
+            for (uint8_t i = 0; i < 6; ++i)
+                counts[i] += pipe_rings[i] ? pipe_rings[i]->size() : 0;
+        }
+        py::tuple pending(6);
+        for (uint8_t i = 0; i < 6; ++i)
+            pending[i] = counts[i];
+        return pending;
+    }
+
+    py::tuple get_rx_worker_pipe_dropped()
+    {
+        py::tuple dropped(6);
+        for (uint8_t i = 0; i < 6; ++i)
+            dropped[i] = rx_worker_pipe_dropped[i].load();
+        return dropped;
+    }
+
+    py::tuple get_rx_worker_weights()
+    {
+        RadioLock consumer(rx_worker_mutex);
+        py::tuple weights(6);
+        for (uint8_t i = 0; i < 6; ++i)
+            weights[i] = pipe_weights[i];
+        return weights;
+    }
+
+    void set_rx_worker_weights(py::iterable weights)
+    {
+        uint8_t values[6];
+        size_t count = 0;
+        for (py::handle weight : weights) {
+            int value = weight.cast<int>();
+            if (count == 6 || value < 1 || value > 255)
+                throw py::value_error("weights must be 6 integers in range [1, 255]");
+            values[count++] = static_cast<uint8_t>(value);
+        }
+        if (count != 6)
+            throw py::value_error("weights must be 6 integers in range [1, 255]");
+        RadioLock consumer(rx_worker_mutex);
+        memcpy(pipe_weights, values, 6);
+        pipe_credit = rf24_min(pipe_credit, pipe_weights[next_pipe]);
+    }
+
+    bool is_rx_worker_running()
+    {
+        return rx_worker_running.load();
+    }
+
+    uint32_t get_rx_worker_dropped()
+    {
+        return rx_worker_dropped.load();
+    }
+
+    py::list read_timestamped()
+    {
+        // the RX FIFO holds 3 payloads; more may arrive while reading them
+        const uint8_t max_count = IrqPin::EDGES * 2;
+        RxRecord records[max_count];
+        uint64_t edges[max_count];
+        uint8_t count = 0;
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(spi_mutex);
+            RadioStats::Timer timer(stats, RadioStats::PAYLOAD_READ);
+            uint8_t edge_count = irq_pin.take_edges(edges);
+            uint64_t polled_ns = monotonic_ns();
+            uint8_t pipe = 7;
+            while (count < max_count && RF24::available(&pipe)) {
+                uint8_t length = rx_payload_length();
+                if (!length)
+                    break; // RX FIFO was flushed (corrupted payload)
+                RxRecord& record = records[count];
+                RF24::read(record.payload, length);
+                record.pipe = pipe;
+                record.length = length;
+                ++count;
+            }
+            refill_ack_payloads();
+            // add the edges of payloads that arrived (and were read) during this call
+            edge_count += irq_pin.take_edges(edges + edge_count);
+            // edges are only paired with payloads by their order, which is only trustworthy if every
+            // payload produced exactly 1 edge (a payload that arrives while the IRQ pin is already
+            // active does not produce an edge, and a payload left in the RX FIFO lost its edge)
+            bool paired = !rx_backlog && edge_count == count;
+            for (uint8_t i = 0; i < count; ++i)
+                records[i].timestamp = paired ? edges[i] : polled_ns;
+            rx_backlog = count == max_count;
+            timer.count = count;
+        }
+        py::list result;
+        for (uint8_t i = 0; i < count; ++i) {
+            result.append(py::make_tuple(
+                records[i].pipe,
+                py::bytes(reinterpret_cast<const char*>(records[i].payload), records[i].length),
+                records[i].timestamp));
+        }
+        return result;
+    }
+
+    void attach_irq(uint32_t pin, const std::string& chip = "/dev/gpiochip0")
+    {
+        if (event_monitor_running.load())
+            throw std::runtime_error("the IRQ pin cannot be changed while the event monitor is running");
+        irq_pin.request(chip, pin);
+    }
+
+    void detach_irq()
+    {
+        if (event_monitor_running.load())
+            throw std::runtime_error("the IRQ pin cannot be changed while the event monitor is running");
+        irq_pin.release();
+    }
+
+    uint8_t wait_irq(int timeout_ms = -1)
+    {
+        if (!irq_pin.is_requested())
+            throw std::runtime_error("the IRQ pin is not attached; use attach_irq() first");
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            int remaining = timeout_ms;
+            if (timeout_ms > 0) {
+                remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                 deadline - std::chrono::steady_clock::now())
+                                                 .count());
+                if (remaining < 0)
+                    remaining = 0;
+            }
+            int result;
+            {
+                py::gil_scoped_release release;
+                result = irq_pin.wait(remaining);
+                if (result > 0) {
+                    std::lock_guard<std::mutex> lock(spi_mutex);
+                    RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+                    // read & clear STATUS in 1 transaction; this also makes the IRQ pin inactive
+                    uint8_t flags = RF24::clearStatusFlags();
+                    if (flags & RF24_IRQ_ALL)
+                        return flags & RF24_IRQ_ALL;
+                }
+            }
+            if (result == 0)
+                return 0;
+            if (result == -EINTR) {
+                if (PyErr_CheckSignals() != 0)
+                    throw py::error_already_set(); // ie. KeyboardInterrupt
+            }
+            else if (result < 0) {
+                errno = -result;
+                PyErr_SetFromErrno(PyExc_OSError);
+                throw py::error_already_set();
+            }
+            // else a stale edge event (flags were already cleared); keep waiting
+            if (timeout_ms == 0)
+                return 0;
+        }
+    }
+
+    void start_event_monitor(uint32_t poll_interval_us = 250)
+    {
+        RadioLock consumer(event_monitor_mutex);
+        if (event_monitor_running.load())
+            throw std::runtime_error("the event monitor thread is already running");
+        open_event_fd();
+        event_monitor_running.store(true);
+        event_monitor = std::thread(&RF24Wrapper::event_monitor_loop, this, std::chrono::microseconds(poll_interval_us));
+    }
+
+    void stop_event_monitor()
+    {
+        RadioLock consumer(event_monitor_mutex);
+        py::gil_scoped_release release;
+        join_event_monitor();
+    }
+
+    int get_event_fileno()
+    {
+        return event_fd;
+    }
+
+    uint8_t take_events(uint8_t mask = RF24_IRQ_ALL);
+
+    std::tuple<uint32_t, uint32_t, uint32_t> write_stream(py::buffer buf, uint8_t size, const bool multicast = false, uint32_t max_retries = 100)
+    {
+        if (!size || size > 32)
+            throw py::value_error("payload_size must be in range [1, 32]");
+        BufferView view(buf, false);
+        const uint8_t* data = view.data();
+        Py_ssize_t remaining = view.size();
+        uint32_t sent = 0, failures = 0;
+
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        auto start = std::chrono::steady_clock::now();
+        bool aborted = false;
+        while (remaining > 0) {
+            uint8_t length = static_cast<uint8_t>(rf24_min(remaining, static_cast<Py_ssize_t>(size)));
+            if (RF24::writeFast(data, length, multicast)) {
+                data += length;
+                remaining -= length;
+                ++sent;
+            }
+            else if (!recover_tx_df(failures, max_retries)) {
+                aborted = true;
+                break;
+            }
+        }
+        // let the radio finish transmitting what remains in the TX FIFO
+        while (!aborted) {
+            rf24_fifo_state_e tx_fifo = RF24::isFifo(true);
+            if (tx_fifo == RF24_FIFO_EMPTY || tx_fifo == RF24_FIFO_INVALID)
+                break;
+            if (RF24::getStatusFlags() & RF24_TX_DF)
+                aborted = !recover_tx_df(failures, max_retries);
+        }
+        RF24::ce(LOW);
+        if (aborted)
+            RF24::flush_tx();
+        timer.count = sent;
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::tuple<uint32_t, uint32_t, uint32_t>(
+            sent, failures,
+            static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+
+    /**
+     * Sweep the given ``channels`` ``passes`` times, accumulating the RPD and packet detections
+     * of each channel into ``out`` (2 ``uint32_t`` counts per channel). See the binding's docstring.
+     */
+    py::object scan(py::iterable channels, uint32_t dwell_us, uint32_t passes, py::object out, py::object callback);
+
     void startFastWrite(py::buffer buf, const bool multicast = false, bool startTx = true)
     {
-        RF24::startFastWrite(
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            multicast, startTx);
+        BufferView view(buf, false);
+        uint8_t length = payload_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        RF24::startFastWrite(view.data(), length, multicast, startTx);
     }
 
     bool startWrite(py::buffer buf, const bool multicast)
     {
-        return RF24::startWrite(
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            multicast);
+        BufferView view(buf, false);
+        uint8_t length = payload_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        return RF24::startWrite(view.data(), length, multicast);
     }
 
     bool writeFast(py::buffer buf, const bool multicast = false)
     {
-        return RF24::writeFast(
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            multicast);
+        BufferView view(buf, false);
+        uint8_t length = payload_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        return RF24::writeFast(view.data(), length, multicast);
     }
 
     bool write(py::buffer buf, const bool multicast = false)
     {
-        return RF24::write(
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            multicast);
+        BufferView view(buf, false);
+        uint8_t length = payload_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        if (link_adapter.enabled)
+            return adaptive_write(view.data(), length, multicast);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        return RF24::write(view.data(), length, multicast);
+    }
+
+    void enable_link_adaptation(uint32_t window, rf24_pa_dbm_e min_pa_level, rf24_pa_dbm_e max_pa_level,
+                                py::object slowest_data_rate, py::object fastest_data_rate,
+                                uint8_t min_delay, uint8_t max_delay, uint8_t min_count, uint8_t max_count)
+    {
+        if (!window)
+            throw py::value_error("window must be greater than 0");
+        if (max_delay > 15 || max_count > 15)
+            throw py::value_error("max_delay and max_count must be in range [0, 15]");
+        if (min_delay > max_delay || min_count > max_count || min_pa_level > max_pa_level)
+            throw py::value_error("a minimum bound is greater than its maximum bound");
+        // the python arguments are converted before locking spi_mutex (converting may run python code)
+        const bool slowest_current = slowest_data_rate.is_none();
+        const bool fastest_current = fastest_data_rate.is_none();
+        uint8_t slowest = slowest_current ? 0 : LinkAdapter::rate_rank(slowest_data_rate.cast<rf24_datarate_e>());
+        uint8_t fastest = fastest_current ? 0 : LinkAdapter::rate_rank(fastest_data_rate.cast<rf24_datarate_e>());
+        RadioLock lock(spi_mutex);
+        uint8_t current_rank = LinkAdapter::rate_rank(get_data_rate());
+        if (slowest_current)
+            slowest = current_rank;
+        if (fastest_current)
+            fastest = current_rank;
+        if (slowest > fastest)
+            throw py::value_error("slowest_data_rate is faster than fastest_data_rate");
+        LinkBounds& bounds = link_adapter.bounds;
+        bounds.min.delay = min_delay;
+        bounds.max.delay = max_delay;
+        bounds.min.count = min_count;
+        bounds.max.count = max_count;
+        bounds.min.pa_level = static_cast<uint8_t>(min_pa_level);
+        bounds.max.pa_level = static_cast<uint8_t>(max_pa_level);
+        bounds.min.rate_rank = slowest;
+        bounds.max.rate_rank = fastest;
+        link_adapter.window = window;
+        link_adapter.reset();
+        link_adapter.enabled = true;
+    }
+
+    void disable_link_adaptation()
+    {
+        RadioLock lock(spi_mutex);
+        link_adapter.enabled = false;
+    }
+
+    bool is_link_adaptation_enabled()
+    {
+        return link_adapter.enabled;
+    }
+
+    py::dict get_link_stats()
+    {
+        std::vector<LinkAdapter::Destination> destinations;
+        {
+            RadioLock lock(spi_mutex);
+            destinations = link_adapter.get_destinations();
+        }
+        py::dict result;
+        for (const LinkAdapter::Destination& dest : destinations) {
+            py::dict entry;
+            entry["settings"] = link_settings_tuple(dest.settings);
+            entry["window"] = link_window_tuple(dest.current);
+            entry["last_window"] = link_window_tuple(dest.last);
+            entry["decisions"] = dest.decisions;
+            result[py::bytes(reinterpret_cast<const char*>(dest.address), 5)] = entry;
+        }
+        return result;
+    }
+
+    py::list get_link_decisions()
+    {
+        std::vector<LinkAdapter::Decision> decisions;
+        {
+            RadioLock lock(spi_mutex);
+            decisions = link_adapter.get_decisions();
+        }
+        py::list result;
+        for (const LinkAdapter::Decision& decision : decisions) {
+            result.append(py::make_tuple(
+                decision.timestamp,
+                py::bytes(reinterpret_cast<const char*>(decision.address), 5),
+                LinkAdapter::reason_name(decision.reason),
+                link_settings_tuple(decision.settings),
+                link_window_tuple(decision.window)));
+        }
+        return result;
     }
 
     bool writeBlocking(py::buffer buf, uint32_t timeout)
     {
-        return RF24::writeBlocking(
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            timeout);
+        BufferView view(buf, false);
+        uint8_t length = payload_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        return RF24::writeBlocking(view.data(), length, timeout);
+    }
+
+    size_t queue_ack_payloads(uint8_t pipe, py::iterable payloads)
+    {
+        if (pipe > 5)
+            throw py::value_error("pipe must be in range [0, 5]");
+        // copy the payloads before locking the radio (iterating may run arbitrary python code)
+        std::vector<AckPayload> pending;
+        for (py::handle payload : payloads) {
+            BufferView view(payload, false);
+            AckPayload ack;
+            ack.length = payload_length(view);
+            memcpy(ack.payload, view.data(), ack.length);
+            pending.push_back(ack);
+        }
+        RadioLock lock(spi_mutex);
+        if (!ack_queues[pipe])
+            ack_queues[pipe].reset(new BoundedQueue<AckPayload>(ACK_QUEUE_CAPACITY));
+        size_t queued = 0;
+        while (queued < pending.size() && ack_queues[pipe]->push(pending[queued]))
+            ++queued;
+        ack_queued += queued;
+        refill_ack_payloads();
+        return queued;
+    }
+
+    size_t get_ack_payloads_queued(uint8_t pipe)
+    {
+        if (pipe > 5)
+            throw py::value_error("pipe must be in range [0, 5]");
+        RadioLock lock(spi_mutex);
+        return ack_queues[pipe] ? ack_queues[pipe]->size() : 0;
+    }
+
+    void clear_ack_payloads()
+    {
+        RadioLock lock(spi_mutex);
+        for (auto& queue : ack_queues) {
+            if (queue)
+                queue->clear();
+        }
+        ack_queued = 0;
+    }
+
+    /**
+     * Top up the TX FIFO with the ACK payloads queued by queue_ack_payloads() (balanced between pipes).
+     * This is done after every payload read from the radio. The SPI mutex must be held.
+     */
+    void refill_ack_payloads()
+    {
+        if (!ack_queued || !RF24::ack_payloads_enabled)
+            return;
+        RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+        rf24_fifo_state_e tx_fifo = RF24::isFifo(true);
+        if (tx_fifo == RF24_FIFO_EMPTY)
+            memset(ack_loaded, 0, sizeof(ack_loaded));
+        uint32_t write_count = 0;
+        while (ack_queued && (tx_fifo == RF24_FIFO_EMPTY || tx_fifo == RF24_FIFO_OCCUPIED)) {
+            uint8_t pipe = 6;
+            for (uint8_t i = 0; i < 6; ++i) {
+                if (ack_queues[i] && ack_queues[i]->size() && (pipe == 6 || ack_loaded[i] < ack_loaded[pipe]))
+                    pipe = i;
+            }
+            AckPayload ack;
+            ack_queues[pipe]->pop(ack);
+            --ack_queued;
+            timer.operation = RadioStats::PAYLOAD_WRITE;
+            timer.count = ++write_count;
+            RF24::writeAckPayload(pipe, ack.payload, ack.length);
+            ++ack_loaded[pipe];
+            tx_fifo = RF24::isFifo(true);
+        }
     }
 
     bool writeAckPayload(uint8_t pipe, py::buffer buf)
     {
-        return RF24::writeAckPayload(
-            pipe,
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)));
+        BufferView view(buf, false);
+        RadioLock lock(spi_mutex);
+        RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+        return RF24::writeAckPayload(pipe, view.data(), payload_length(view));
+    }
+
+    /** The size of a snapshot_registers() blob. */
+    static const uint8_t REGISTER_SNAPSHOT_SIZE = 45;
+
+    py::bytes snapshot_registers()
+    {
+        uint8_t blob[REGISTER_SNAPSHOT_SIZE];
+        {
+            RadioLock lock(spi_mutex);
+            read_snapshot(blob);
+        }
+        return py::bytes(reinterpret_cast<char*>(blob), REGISTER_SNAPSHOT_SIZE);
     }
 
-    char* sprintfDetails()
+    void restore_registers(py::buffer blob)
     {
-        char* debug_info = new char[870];
+        BufferView view(blob, false);
+        if (view.size() != REGISTER_SNAPSHOT_SIZE)
+            throw py::value_error("blob must be a snapshot_registers() result (45 bytes)");
+        uint8_t target[REGISTER_SNAPSHOT_SIZE];
+        memcpy(target, view.data(), REGISTER_SNAPSHOT_SIZE);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24Wrapper> changed(*this);
+        write_snapshot(target);
+    }
+
+    std::string sprintfDetails()
+    {
+        char debug_info[870];
         RF24::sprintfPrettyDetails(debug_info);
-        return debug_info;
+        return std::string(debug_info);
     }
 
     void set_radiation(rf24_pa_dbm_e level, rf24_datarate_e speed, bool lna_enable = true)
@@ -176,7 +1274,76 @@ public:
 
     bool isPowerUp()
     {
-        return read_register(CONFIG) & _BV(PWR_UP);
+        return cached_register(CONFIG) & _BV(PWR_UP);
+    }
+
+    uint8_t get_channel()
+    {
+        return cached_register(RF_CH);
+    }
+
+    rf24_crclength_e get_crc_length()
+    {
+        // same as RF24::getCRCLength()
+        uint8_t config = cached_register(CONFIG);
+        if (config & _BV(EN_CRC) || cached_register(EN_AA))
+            return config & _BV(CRCO) ? RF24_CRC_16 : RF24_CRC_8;
+        return RF24_CRC_DISABLED;
+    }
+
+    bool get_register_shadow()
+    {
+        return shadow_enabled;
+    }
+
+    void set_register_shadow(const bool enable)
+    {
+        shadow_enabled = enable;
+        shadow_valid = 0;
+        spi_reads_saved = 0;
+    }
+
+    void resync_registers()
+    {
+        shadow_valid = 0;
+        for (uint8_t i = 0; i < SHADOWED_REGISTERS; ++i)
+            cached_register(shadowed_register(i));
+    }
+
+    /** Forget the cached registers, so they are read from the radio the next time they are needed. */
+    void invalidate_registers()
+    {
+        shadow_valid = 0;
+    }
+
+    uint32_t get_spi_reads_saved()
+    {
+        return spi_reads_saved;
+    }
+
+    py::dict get_stats()
+    {
+        py::dict result;
+        for (int i = 0; i < RadioStats::OPERATIONS; ++i) {
+            const RadioStats::Counter& counter = stats.counters[i];
+            result[RadioStats::name(i)] = py::make_tuple(counter.count, counter.total_ns, counter.max_ns);
+        }
+        return result;
+    }
+
+    void reset_stats()
+    {
+        stats.reset();
+    }
+
+    bool get_stats_enabled()
+    {
+        return stats.enabled;
+    }
+
+    void set_stats_enabled(bool enable)
+    {
+        stats.enabled = enable;
     }
 
     void set_pa_level(rf24_pa_dbm_e level)
@@ -186,7 +1353,8 @@ public:
 
     rf24_pa_dbm_e get_pa_level()
     {
-        uint8_t ret_val = RF24::getPALevel();
+        // same as RF24::getPALevel()
+        uint8_t ret_val = (cached_register(RF_SETUP) & (_BV(RF_PWR_LOW) | _BV(RF_PWR_HIGH))) >> 1;
         if (ret_val == RF24_PA_MAX)
             return RF24_PA_MAX;
         if (ret_val == RF24_PA_HIGH)
@@ -199,13 +1367,13 @@ public:
 
     rf24_datarate_e get_data_rate()
     {
-        uint8_t ret_val = RF24::getDataRate();
-        if (ret_val == RF24_2MBPS)
+        // same as RF24::getDataRate()
+        uint8_t ret_val = cached_register(RF_SETUP) & (_BV(RF_DR_LOW) | _BV(RF_DR_HIGH));
+        if (ret_val == _BV(RF_DR_HIGH))
             return RF24_2MBPS;
-        if (ret_val == RF24_1MBPS)
-            return RF24_1MBPS;
-        // if (ret_val == RF24_250KBPS)
-        return RF24_250KBPS;
+        if (ret_val == _BV(RF_DR_LOW))
+            return RF24_250KBPS;
+        return RF24_1MBPS;
     }
 
     void power(const bool enable)
@@ -218,7 +1386,7 @@ public:
 
     bool isListening()
     {
-        return read_register(CONFIG) & _BV(PRIM_RX);
+        return cached_register(CONFIG) & _BV(PRIM_RX);
     }
 
     void listen(const bool enable)
@@ -228,6 +1396,303 @@ public:
         else
             stopListening();
     }
+
+private:
+    /** The number of registers in the register shadow (see set_register_shadow()). */
+    static const uint8_t SHADOWED_REGISTERS = 8;
+
+    /** Get the register address at ``index`` of the register shadow. */
+    static uint8_t shadowed_register(uint8_t index)
+    {
+        static const uint8_t registers[SHADOWED_REGISTERS] = {CONFIG, EN_AA, EN_RXADDR, SETUP_RETR, RF_CH, RF_SETUP, DYNPD, FEATURE};
+        return registers[index];
+    }
+
+    /** Only changed by this process, so they can be cached while the radio's configuration is unchanged. */
+    bool shadow_enabled = false;
+    /** A bit for each shadowed register that is currently cached. */
+    uint8_t shadow_valid = 0;
+    uint8_t shadow_values[SHADOWED_REGISTERS];
+    uint32_t spi_reads_saved = 0;
+
+    /** Read a register, using the register shadow (if enabled). The SPI mutex must be held. */
+    uint8_t cached_register(uint8_t reg)
+    {
+        uint8_t index = 0;
+        while (index < SHADOWED_REGISTERS && shadowed_register(index) != reg)
+            ++index;
+        if (!shadow_enabled || index == SHADOWED_REGISTERS) {
+            RadioStats::Timer timer(stats, RadioStats::REGISTER_READ);
+            return read_register(reg);
+        }
+        if (shadow_valid & _BV(index)) {
+            ++spi_reads_saved;
+            return shadow_values[index];
+        }
+        RadioStats::Timer timer(stats, RadioStats::REGISTER_READ);
+        shadow_values[index] = read_register(reg);
+        shadow_valid |= _BV(index);
+        return shadow_values[index];
+    }
+
+    /** The maximum number of ACK payloads queued for each pipe (see queue_ack_payloads()). */
+    static const size_t ACK_QUEUE_CAPACITY = 64;
+    /** The ACK payloads queued for each pipe (guarded by spi_mutex). */
+    std::unique_ptr<BoundedQueue<AckPayload>> ack_queues[6];
+    /** The total number of ACK payloads in ack_queues. */
+    size_t ack_queued = 0;
+    /** The ACK payloads loaded into the TX FIFO for each pipe since the TX FIFO was last empty. */
+    uint8_t ack_loaded[6] = {0, 0, 0, 0, 0, 0};
+
+    /** The opt-in link adaptation of write() (see enable_link_adaptation()). Guarded by spi_mutex. */
+    LinkAdapter link_adapter;
+
+    /** The radio's current settings that are tuned by link_adapter. The SPI mutex must be held. */
+    LinkSettings current_link_settings()
+    {
+        uint8_t setup_retr = cached_register(SETUP_RETR);
+        LinkSettings settings;
+        settings.delay = setup_retr >> ARD;
+        settings.count = setup_retr & 0x0F;
+        settings.pa_level = static_cast<uint8_t>(get_pa_level());
+        settings.rate_rank = LinkAdapter::rate_rank(get_data_rate());
+        return settings;
+    }
+
+    /** Reconfigure the radio with ``settings`` (only the registers that differ). The SPI mutex must be held. */
+    void apply_link_settings(const LinkSettings& settings)
+    {
+        LinkSettings current = current_link_settings();
+        if (current == settings)
+            return;
+        RegistersChanged<RF24Wrapper> changed(*this);
+        RadioStats::Timer timer(stats, RadioStats::REGISTER_WRITE);
+        if (current.delay != settings.delay || current.count != settings.count)
+            RF24::setRetries(settings.delay, settings.count);
+        if (current.pa_level != settings.pa_level)
+            RF24::setPALevel(settings.pa_level, cached_register(RF_SETUP) & 1);
+        if (current.rate_rank != settings.rate_rank)
+            RF24::setDataRate(static_cast<rf24_datarate_e>(LinkAdapter::rate_of(settings.rate_rank)));
+    }
+
+    /**
+     * RF24::write() with the link settings of the current destination (the TX address),
+     * recording the outcome in link_adapter. The SPI mutex must be held.
+     */
+    bool adaptive_write(const uint8_t* buf, uint8_t length, const bool multicast)
+    {
+        uint8_t address[5];
+        bool rpd;
+        {
+            RadioStats::Timer timer(stats, RadioStats::REGISTER_READ);
+            RF24::read_register(TX_ADDR, address, 5);
+            rpd = RF24::testRPD(); // asserted by the channel's activity during the last RX session
+        }
+        LinkAdapter::Destination& dest = link_adapter.destination(address, current_link_settings());
+        apply_link_settings(dest.settings);
+        bool delivered;
+        {
+            RadioStats::Timer timer(stats, RadioStats::PAYLOAD_WRITE);
+            delivered = RF24::write(buf, length, multicast);
+        }
+        if (multicast)
+            return delivered; // nothing is learned without an ACK
+        uint8_t arc;
+        {
+            RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+            arc = RF24::getARC();
+        }
+        if (link_adapter.record(dest, delivered, arc, rpd, monotonic_ns()))
+            apply_link_settings(dest.settings);
+        return delivered;
+    }
+
+    static py::tuple link_settings_tuple(const LinkSettings& settings)
+    {
+        return py::make_tuple(settings.delay, settings.count,
+                              static_cast<rf24_pa_dbm_e>(settings.pa_level),
+                              static_cast<rf24_datarate_e>(LinkAdapter::rate_of(settings.rate_rank)));
+    }
+
+    static py::tuple link_window_tuple(const LinkWindow& window)
+    {
+        return py::make_tuple(window.sends, window.failures, window.arc_total, window.rpd_count);
+    }
+
+    /** The IRQ pin (see attach_irq()). */
+    IrqPin irq_pin;
+    /** Did read_timestamped() leave payloads in the RX FIFO (whose IRQ edges were discarded)? */
+    bool rx_backlog = false;
+
+    /** The RX worker thread (see start_rx_worker()) and its state. */
+    std::thread rx_worker;
+    std::atomic<bool> rx_worker_running{false};
+    std::atomic<uint32_t> rx_worker_dropped{0};
+    /** The ring of all pipes (unless started with ``per_pipe``). */
+    std::unique_ptr<RxRing> rx_ring;
+    /** A ring for each pipe (if started with ``per_pipe``). */
+    std::unique_ptr<RxRing> pipe_rings[6];
+    std::atomic<uint32_t> rx_worker_pipe_dropped[6] = {};
+    /** The weighted round-robin state of rx_worker_pop() (guarded by rx_worker_mutex). */
+    uint8_t pipe_weights[6] = {1, 1, 1, 1, 1, 1};
+    uint8_t next_pipe = 0;
+    uint8_t pipe_credit = 1;
+    /** Serializes the consumer side of rx_ring and the starting/stopping of rx_worker. */
+    std::mutex rx_worker_mutex;
+
+    /** Move the oldest record of ``ring`` (if any) into ``records``. Returns false if ``ring`` is empty. */
+    static bool pop_record(RxRing& ring, py::list& records)
+    {
+        const RxRecord* record = ring.front();
+        if (record == nullptr)
+            return false;
+        records.append(py::make_tuple(
+            record->pipe,
+            py::bytes(reinterpret_cast<const char*>(record->payload), record->length),
+            record->timestamp));
+        ring.pop();
+        return true;
+    }
+
+    /** Drain the RX FIFO into rx_ring (or pipe_rings) until rx_worker_running is cleared. Runs without the GIL. */
+    void rx_worker_loop(std::chrono::microseconds poll_interval)
+    {
+        RxRecord discard;
+        while (rx_worker_running.load(std::memory_order_acquire)) {
+            bool received = false;
+            {
+                std::lock_guard<std::mutex> lock(spi_mutex);
+                RadioStats::Timer timer(stats, RadioStats::STATUS_POLL);
+                uint32_t read_count = 0;
+                uint8_t pipe = 7;
+                while (RF24::available(&pipe)) {
+                    timer.operation = RadioStats::PAYLOAD_READ;
+                    timer.count = ++read_count;
+                    uint8_t length = rx_payload_length();
+                    if (!length)
+                        break; // RX FIFO was flushed (corrupted payload)
+                    RxRing* ring = rx_ring ? rx_ring.get() : pipe_rings[pipe % 6].get();
+                    RxRecord* record = ring->claim();
+                    if (record == nullptr) {
+                        record = &discard; // still empty the radio's RX FIFO
+                        rx_worker_dropped.fetch_add(1);
+                        rx_worker_pipe_dropped[pipe % 6].fetch_add(1);
+                    }
+                    RF24::read(record->payload, length);
+                    record->timestamp = monotonic_ns();
+                    record->pipe = pipe;
+                    record->length = length;
+                    if (record != &discard)
+                        ring->publish();
+                    received = true;
+                }
+                if (received)
+                    refill_ack_payloads();
+            }
+            if (!received)
+                std::this_thread::sleep_for(poll_interval);
+        }
+    }
+
+    /** Stop the RX worker thread (if running). The worker never acquires the GIL. */
+    void join_rx_worker()
+    {
+        rx_worker_running.store(false, std::memory_order_release);
+        if (rx_worker.joinable())
+            rx_worker.join();
+    }
+
+    /** The event monitor thread (see start_event_monitor()) and its state. */
+    std::thread event_monitor;
+    std::atomic<bool> event_monitor_running{false};
+    /** The status flags observed (and cleared) by the event monitor that were not yet taken. */
+    uint8_t pending_events = 0;
+    /** An eventfd that is readable while pending_events is not empty. */
+    int event_fd = -1;
+    /** Guards pending_events and the readability of event_fd, so they always change together. */
+    std::mutex events_mutex;
+    /** Serializes the starting/stopping of event_monitor. */
+    std::mutex event_monitor_mutex;
+
+    /** Watch the IRQ pin (or poll the STATUS byte) until event_monitor_running is cleared. Runs without the GIL. */
+    void event_monitor_loop(std::chrono::microseconds poll_interval);
+
+    /** Stop the event monitor thread (if running). The thread never acquires the GIL. */
+    void join_event_monitor()
+    {
+        event_monitor_running.store(false, std::memory_order_release);
+        if (event_monitor.joinable())
+            event_monitor.join();
+    }
+
+    /** Create event_fd (if not already created). Raises OSError on failure (requires the GIL). */
+    void open_event_fd();
+
+    void close_event_fd();
+
+    /**
+     * Re-attempt a failed transmission (the payload remains in the TX FIFO) by clearing the
+     * TX_DF flag and pulsing the CE pin.
+     * Returns false (without re-attempting) if `failures` has exceeded `max_retries`.
+     */
+    bool recover_tx_df(uint32_t& failures, uint32_t max_retries)
+    {
+        if (++failures > max_retries)
+            return false;
+        RF24::ce(LOW);
+        RF24::clearStatusFlags(RF24_TX_DF);
+        RF24::ce(HIGH);
+        return true;
+    }
+
+    /** The offset of the 5-byte RX_ADDR_P0, RX_ADDR_P1, and TX_ADDR values in a register snapshot. */
+    static const uint8_t SNAPSHOT_ADDRESSES = 30;
+
+    /**
+     * Read all registers into ``blob`` (REGISTER_SNAPSHOT_SIZE bytes): the first byte of registers
+     * 0x00 to 0x1D (the reserved registers 0x18 to 0x1B are stored as 0), followed by the full
+     * RX_ADDR_P0, RX_ADDR_P1, and TX_ADDR values. The SPI mutex must be held.
+     */
+    void read_snapshot(uint8_t* blob);
+
+    /**
+     * Reconfigure the radio to match a register snapshot, changing only the registers that differ from
+     * 1 snapshot of the radio's current registers. Every change uses RF24's setters (so its cached state
+     * stays in sync). The SPI mutex must be held.
+     */
+    void write_snapshot(const uint8_t* target);
+
+    /** Flags of each channel in a scan() pass. */
+    static const uint8_t SCAN_RPD = 1;
+    static const uint8_t SCAN_PACKET = 2;
+
+    /**
+     * Listen on each of the ``channels`` for ``dwell`` and store the detections of each channel
+     * in ``flags`` (see SCAN_RPD and SCAN_PACKET). The radio's channel and RX/TX mode are restored
+     * afterward. The SPI mutex is taken for each channel, so it must not be held (and the GIL should be released).
+     */
+    void scan_pass(const std::vector<uint8_t>& channels, std::chrono::microseconds dwell, uint8_t* flags);
+
+    /** The length of a payload in ``view`` (truncated to the maximum payload size of 32 bytes). */
+    static uint8_t payload_length(const BufferView& view)
+    {
+        return static_cast<uint8_t>(rf24_min(view.size(), static_cast<Py_ssize_t>(32)));
+    }
+
+    /**
+     * Get an address (up to 5 bytes) from ``view`` without copying it.
+     * Shorter addresses are copied into ``padded`` (with trailing zeros), so that the radio's
+     * address width never reads beyond the python object's buffer.
+     */
+    static const uint8_t* address_of(BufferView& view, uint8_t* padded)
+    {
+        if (view.size() >= 5)
+            return view.data();
+        memset(padded, 0, 5);
+        if (view.size() > 0)
+            memcpy(padded, view.data(), static_cast<size_t>(view.size()));
+        return padded;
+    }
 };
 
 #endif // PYRF24_H
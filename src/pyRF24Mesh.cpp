@@ -31,11 +31,11 @@ void init_rf24mesh(py::module& m)
             :param RF24Network network: The `RF24Network` object used to provide the base
                 networking layer.
         )docstr",
-             py::arg("radio"), py::arg("network"))
+             py::arg("radio"), py::arg("network"), py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
 
         // *****************************************************************************
 
-        .def("begin", &RF24MeshWrapper::begin, R"docstr(
+        .def("begin", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::begin), R"docstr(
             begin(channel: int = 97, data_rate: pyrf24.rf24_datarate_e = RF24_1MBPS, timeout: int = 7500) -> bool
 
             :param int channel: The :py:attr:`~pyrf24.RF24.channel` to use for the network.
@@ -54,7 +54,7 @@ void init_rf24mesh(py::module& m)
 
         // *****************************************************************************
 
-        .def("update", &RF24MeshWrapper::update, R"docstr(
+        .def("update", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::update), R"docstr(
             update() -> int
 
             Keep the mesh network layer current. This function should be called regularly in the application.
@@ -66,13 +66,15 @@ void init_rf24mesh(py::module& m)
         // *****************************************************************************
 
         .def("write", static_cast<bool (RF24MeshWrapper::*)(py::buffer, uint8_t, uint8_t)>(&RF24MeshWrapper::write), R"docstr(
-            write(buf: Union[bytes, bytearray], message_type: int, to_node_id: int = 0) -> bool \
-            write(to_node_address: int, buf: Union[bytes, bytearray], message_type: int) -> bool
+            write(buf: Buffer, message_type: int, to_node_id: int = 0) -> bool \
+            write(to_node_address: int, buf: Buffer, message_type: int) -> bool
 
-            :param bytes,bytearray buf: The message to transmit.
+            :param Buffer buf: The message to transmit. Messages longer than 24 bytes are fragmented
+                (up to :py:attr:`~pyrf24.MAX_PAYLOAD_SIZE` bytes).
             :param int message_type: The :py:attr:`~pyrf24.RF24NetworkHeader.type` to
                 be used in the frame's header.
             :Returns: `True` if the message was successfully sent, otherwise `False`
+            :raises ValueError: if ``buf`` is longer than :py:attr:`~pyrf24.MAX_PAYLOAD_SIZE`.
 
             Transmit a message to a unique `node_id` of a mesh network node, use the following parameter:
 
@@ -94,7 +96,7 @@ void init_rf24mesh(py::module& m)
 
         // *****************************************************************************
 
-        .def("set_address", &RF24MeshWrapper::setAddress, R"docstr(
+        .def("set_address", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::setAddress), R"docstr(
             set_address(node_id: int, address: int, search_by_address: bool = False)
 
             Only call this function on a mesh network's master node to manually assign a logical
@@ -121,14 +123,14 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("node_id"), py::arg("address"), py::arg("search_by_address") = false)
 
-        .def("setAddress", &RF24MeshWrapper::setAddress, R"docstr(
+        .def("setAddress", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::setAddress), R"docstr(
             setAddress(node_id: int, address: int, search_by_address: bool = False)
         )docstr",
              py::arg("node_id"), py::arg("address"), py::arg("search_by_address") = false)
 
         // *****************************************************************************
 
-        .def("setStaticAddress", &RF24MeshWrapper::setStaticAddress, R"docstr(
+        .def("setStaticAddress", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::setStaticAddress), R"docstr(
             setStaticAddress(node_id: int, address: int)
 
             For backwards compatiblity only, this function is similar to the `set_address()` function.
@@ -137,7 +139,7 @@ void init_rf24mesh(py::module& m)
 
         // *****************************************************************************
 
-        .def("save_dhcp", &RF24MeshWrapper::saveDHCP, R"docstr(
+        .def("save_dhcp", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::saveDHCP), R"docstr(
             save_dhcp()
 
             Call this function on the mesh network's master node to save the current list of
@@ -145,13 +147,13 @@ void init_rf24mesh(py::module& m)
             master node needs to go offline.
         )docstr")
 
-        .def("saveDHCP", &RF24MeshWrapper::saveDHCP, R"docstr(
+        .def("saveDHCP", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::saveDHCP), R"docstr(
             saveDHCP()
         )docstr")
 
         // *****************************************************************************
 
-        .def("load_dhcp", &RF24MeshWrapper::loadDHCP, R"docstr(
+        .def("load_dhcp", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::loadDHCP), R"docstr(
             load_dhcp()
 
             Call this function on the mesh network's master node to read and load the saved list of
@@ -159,13 +161,13 @@ void init_rf24mesh(py::module& m)
             master node resumes operation after being offline.
         )docstr")
 
-        .def("loadDHCP", &RF24MeshWrapper::loadDHCP, R"docstr(
+        .def("loadDHCP", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::loadDHCP), R"docstr(
             loadDHCP()
         )docstr")
 
         // *****************************************************************************
 
-        .def("dhcp", &RF24MeshWrapper::DHCP, R"docstr(
+        .def("dhcp", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::DHCP), R"docstr(
             dhcp()
 
             Keep the master node's list of assigned addresses up-to-date.
@@ -174,7 +176,7 @@ void init_rf24mesh(py::module& m)
                 after calling :py:meth:`~pyrf24.RF24Mesh.update()`.
         )docstr")
 
-        .def("DHCP", &RF24MeshWrapper::DHCP, R"docstr(
+        .def("DHCP", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::DHCP), R"docstr(
             DHCP()
         )docstr")
 
@@ -218,7 +220,7 @@ void init_rf24mesh(py::module& m)
 
         // *****************************************************************************
 
-        .def("get_node_id", &RF24MeshWrapper::getNodeID, R"docstr(
+        .def("get_node_id", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::getNodeID), R"docstr(
             get_node_id(address: int = 0xFFFF) -> int
 
             Translates a `node_id` into the corresponding `mesh_address`
@@ -235,14 +237,14 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("address") = 0xFFFF)
 
-        .def("getNodeID", &RF24MeshWrapper::getNodeID, R"docstr(
+        .def("getNodeID", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::getNodeID), R"docstr(
             getNodeID(address: int = 0xFFFF) -> int
         )docstr",
              py::arg("address") = 0xFFFF)
 
         // *****************************************************************************
 
-        .def("check_connection", &RF24MeshWrapper::checkConnection, R"docstr(
+        .def("check_connection", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::checkConnection), R"docstr(
             check_connection() -> bool
 
             Check for connectivity with the mesh network.
@@ -252,13 +254,13 @@ void init_rf24mesh(py::module& m)
             :Returns: `True` if connected, otherwise `False`
         )docstr")
 
-        .def("checkConnection", &RF24MeshWrapper::checkConnection, R"docstr(
+        .def("checkConnection", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::checkConnection), R"docstr(
             checkConnection() -> bool
         )docstr")
 
         // *****************************************************************************
 
-        .def("renew_address", &RF24MeshWrapper::renewAddress, R"docstr(
+        .def("renew_address", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::renewAddress), R"docstr(
             renew_address(timeout: int = 7500) -> int
 
             Attempt to get a new `Logical Address <logical_address>` assigned from the mesh network's master node.
@@ -274,14 +276,14 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("timeout") = 7500)
 
-        .def("renewAddress", &RF24MeshWrapper::renewAddress, R"docstr(
+        .def("renewAddress", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::renewAddress), R"docstr(
             renewAddress(timeout: int = 7500) -> int
         )docstr",
              py::arg("timeout") = 7500)
 
         // *****************************************************************************
 
-        .def("release_address", static_cast<bool (RF24MeshWrapper::*)()>(&RF24MeshWrapper::releaseAddress), R"docstr(
+        .def("release_address", gil_released<RF24MeshWrapper>(static_cast<bool (RF24MeshWrapper::*)()>(&RF24MeshWrapper::releaseAddress)), R"docstr(
             release_address() -> bool \
             release_address(address: int) -> bool
 
@@ -297,14 +299,14 @@ void init_rf24mesh(py::module& m)
                 - `False` means the wireless transaction did not complete.
         )docstr")
 
-        .def("releaseAddress", static_cast<bool (RF24MeshWrapper::*)()>(&RF24MeshWrapper::releaseAddress), R"docstr(
+        .def("releaseAddress", gil_released<RF24MeshWrapper>(static_cast<bool (RF24MeshWrapper::*)()>(&RF24MeshWrapper::releaseAddress)), R"docstr(
             releaseAddress() -> bool
         )docstr")
 
     // *****************************************************************************
 #ifndef MESH_NOMASTER
 
-        .def("release_address", static_cast<bool (RF24MeshWrapper::*)(uint16_t)>(&RF24MeshWrapper::releaseAddress), R"docstr(
+        .def("release_address", gil_released<RF24MeshWrapper>(static_cast<bool (RF24MeshWrapper::*)(uint16_t)>(&RF24MeshWrapper::releaseAddress)), R"docstr(
             When called from the master node, this function takes a parameter and returns
             without using wireless transactions.
 
@@ -320,7 +322,7 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("address"))
 
-        .def("releaseAddress", static_cast<bool (RF24MeshWrapper::*)(uint16_t)>(&RF24MeshWrapper::releaseAddress), R"docstr(
+        .def("releaseAddress", gil_released<RF24MeshWrapper>(static_cast<bool (RF24MeshWrapper::*)(uint16_t)>(&RF24MeshWrapper::releaseAddress)), R"docstr(
             releaseAddress(address: int) -> bool
         )docstr",
              py::arg("address"))
@@ -328,7 +330,7 @@ void init_rf24mesh(py::module& m)
 #endif
         // *****************************************************************************
 
-        .def("get_address", &RF24MeshWrapper::getAddress, R"docstr(
+        .def("get_address", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::getAddress), R"docstr(
             get_address(node_id: int) -> int
 
             Translates a `node_id` into the corresponding `mesh_address`
@@ -346,14 +348,14 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("node_id"))
 
-        .def("getAddress", &RF24MeshWrapper::getAddress, R"docstr(
+        .def("getAddress", gil_released<RF24MeshWrapper>(&RF24MeshWrapper::getAddress), R"docstr(
             getAddress(node_id: int) -> int
         )docstr",
              py::arg("node_id"))
 
         // *****************************************************************************
 
-        .def("set_channel", &RF24MeshWrapper::setChannel, R"docstr(
+        .def("set_channel", reconfiguring<RF24MeshWrapper>(&RF24MeshWrapper::setChannel), R"docstr(
             set_channel(channel: int)
             This function controls the radio's configured `channel` (AKA frequency).
 
@@ -361,14 +363,14 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("channel"))
 
-        .def("setChannel", &RF24MeshWrapper::setChannel, R"docstr(
+        .def("setChannel", reconfiguring<RF24MeshWrapper>(&RF24MeshWrapper::setChannel), R"docstr(
             setChannel(channel: int)
         )docstr",
              py::arg("channel"))
 
         // *****************************************************************************
 
-        .def("set_child", &RF24MeshWrapper::setChild, R"docstr(
+        .def("set_child", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::setChild), R"docstr(
             set_child(allow: bool)
 
             Control the node's ability to have child nodes connect to it.
@@ -378,7 +380,7 @@ void init_rf24mesh(py::module& m)
         )docstr",
              py::arg("allow"))
 
-        .def("setChild", &RF24MeshWrapper::setChild, R"docstr(
+        .def("setChild", spi_locked<RF24MeshWrapper>(&RF24MeshWrapper::setChild), R"docstr(
             setChild(allow: bool)
         )docstr",
              py::arg("allow"));
@@ -10,29 +10,53 @@ class RF24MeshWrapper : public RF24Mesh
 {
 public:
     RF24MeshWrapper(RF24Wrapper& _radio, RF24NetworkWrapper& _network)
-        : RF24Mesh(static_cast<RF24&>(_radio), static_cast<RF24Network&>(_network))
+        : RF24Mesh(static_cast<RF24&>(_radio), static_cast<RF24Network&>(_network)), spi_mutex(_radio.spi_mutex), stats(_radio.stats), py_radio(_radio)
     {
     }
 
     // needed for polymorphic recognition
     virtual ~RF24MeshWrapper() = default;
 
+    /** The radio's SPI mutex, which also guards the network layer and this mesh layer's DHCP list. */
+    std::mutex& spi_mutex;
+
+    /** The radio's SPI operation stats, so this layer's radio (re)configurations are also counted. */
+    RadioStats& stats;
+
+    /** This mesh layer (re)configures the radio, so the radio's cached registers must be forgotten. */
+    void invalidate_registers()
+    {
+        py_radio.invalidate_registers();
+    }
+
     bool write(py::buffer buf, uint8_t msg_type, uint8_t nodeID = 0)
     {
-        return RF24Mesh::write(
-            get_bytes_or_bytearray_str(buf),
-            msg_type,
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            nodeID);
+        // the buffer stays exported (so it cannot be resized) while the GIL is released
+        BufferView view(buf, false);
+        uint16_t length = message_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24MeshWrapper> changed(*this);
+        return RF24Mesh::write(view.data(), msg_type, length, nodeID);
     }
 
     bool write(uint16_t to_node, py::buffer buf, uint8_t msg_type)
     {
-        return RF24Mesh::write(
-            to_node,
-            get_bytes_or_bytearray_str(buf),
-            msg_type,
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)));
+        // the buffer stays exported (so it cannot be resized) while the GIL is released
+        BufferView view(buf, false);
+        uint16_t length = message_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24MeshWrapper> changed(*this);
+        return RF24Mesh::write(to_node, view.data(), msg_type, length);
+    }
+
+    /** RF24Mesh::update(), then top up the radio's queued ACK payloads. The SPI mutex must be held. */
+    uint8_t update()
+    {
+        uint8_t type = RF24Mesh::update();
+        py_radio.refill_ack_payloads();
+        return type;
     }
 
     uint8_t get_node_id()
@@ -42,12 +66,21 @@ public:
 
     py::list get_addrList()
     {
+        // the list is created after unlocking spi_mutex (allocating may run python code)
+        std::vector<RF24Mesh::addrListStruct> entries;
+        {
+            RadioLock lock(spi_mutex);
+            entries.assign(RF24Mesh::addrList, RF24Mesh::addrList + RF24Mesh::addrListTop);
+        }
         py::list list;
-        for (uint8_t i = 0; i < RF24Mesh::addrListTop; ++i) {
-            list.append(RF24Mesh::addrList[i]);
+        for (const RF24Mesh::addrListStruct& entry : entries) {
+            list.append(entry);
         }
         return list;
     }
+
+private:
+    RF24Wrapper& py_radio;
 };
 
 #endif // PYRF24MESH_H
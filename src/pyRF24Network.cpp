@@ -1,5 +1,191 @@
+#include <sys/eventfd.h>
+#include <unistd.h>
 #include "pyRF24Network.h"
 
+void RF24NetworkWrapper::open_frames_fd()
+{
+    if (frames_fd >= 0)
+        return;
+    frames_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (frames_fd < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        throw py::error_already_set();
+    }
+}
+
+void RF24NetworkWrapper::close_frames_fd()
+{
+    if (frames_fd >= 0) {
+        ::close(frames_fd);
+        frames_fd = -1;
+    }
+}
+
+void RF24NetworkWrapper::frames_taken()
+{
+    if (frames_signaled && !has_frames()) {
+        uint64_t counter;
+        ssize_t consumed = ::read(frames_fd, &counter, sizeof(counter));
+        (void)consumed; // only fails if frames_fd was not readable
+        frames_signaled = false;
+    }
+}
+
+bool RF24NetworkWrapper::has_frames()
+{
+    if (available())
+        return true;
+    for (auto& route : routes) {
+        if (route->queue.size())
+            return true;
+    }
+    return false;
+}
+
+void RF24NetworkWrapper::sort_frames()
+{
+    if (routes.empty())
+        return;
+    RF24NetworkHeader header;
+    DispatchedFrame frame;
+    while (RF24Network::available()) {
+        uint16_t length = RF24Network::peek(header);
+        length = static_cast<uint16_t>(rf24_min(length, MAX_PAYLOAD_SIZE));
+        uint8_t index = route_of[header.type];
+        if (index == NO_ROUTE) {
+            passthrough.emplace_back();
+            DispatchedFrame& unrouted = passthrough.back();
+            unrouted.length = RF24Network::read(unrouted.header, unrouted.message, length);
+            continue;
+        }
+        frame.length = RF24Network::read(frame.header, frame.message, length);
+        if (!routes[index]->queue.push(frame))
+            dispatch_dropped.fetch_add(1);
+    }
+}
+
+uint16_t RF24NetworkWrapper::peek_next(RF24NetworkHeader& header, uint8_t* message, uint16_t maxlen)
+{
+    if (passthrough.empty()) {
+        uint16_t length = RF24Network::peek(header);
+        if (!message)
+            return length;
+        RF24Network::peek(header, message, maxlen);
+        return static_cast<uint16_t>(rf24_min(maxlen, length));
+    }
+    const DispatchedFrame& frame = passthrough.front();
+    header = frame.header;
+    if (!message)
+        return frame.length;
+    uint16_t length = static_cast<uint16_t>(rf24_min(maxlen, frame.length));
+    memcpy(message, frame.message, length);
+    return length;
+}
+
+uint16_t RF24NetworkWrapper::read_next(RF24NetworkHeader& header, uint8_t* message, uint16_t maxlen)
+{
+    if (passthrough.empty())
+        return RF24Network::read(header, message, maxlen);
+    uint16_t length = peek_next(header, message, maxlen);
+    passthrough.pop_front();
+    return length;
+}
+
+void RF24NetworkWrapper::add_dispatch(int first_type, py::object last_type, py::object callback, size_t capacity)
+{
+    int last = last_type.is_none() ? first_type : last_type.cast<int>();
+    // the system types (ie. NETWORK_ADDR_RESPONSE or RF24Mesh's DHCP messages) must stay in the frame queue
+    if (first_type < 0 || last > MAX_USER_DEFINED_HEADER_TYPE || first_type > last)
+        throw py::value_error("header types must be an ascending range within [0, MAX_USER_DEFINED_HEADER_TYPE]");
+    if (!capacity)
+        throw py::value_error("capacity must be greater than 0");
+    if (!callback.is_none() && !PyCallable_Check(callback.ptr()))
+        throw py::value_error("callback must be callable or None");
+    RadioLock lock(spi_mutex);
+    if (routes.size() == NO_ROUTE)
+        throw py::value_error("too many dispatch routes");
+    for (int type = first_type; type <= last; ++type) {
+        if (route_of[type] != NO_ROUTE)
+            throw py::value_error("header type " + std::to_string(type) + " already has a dispatch route");
+    }
+    routes.emplace_back(new DispatchRoute(static_cast<uint8_t>(first_type), static_cast<uint8_t>(last), callback, capacity));
+    memset(route_of + first_type, static_cast<int>(routes.size() - 1), static_cast<size_t>(last - first_type + 1));
+    dispatch_callbacks += !callback.is_none();
+    sort_frames(); // frames that were already queued
+}
+
+py::list RF24NetworkWrapper::pop_frames(DispatchRoute& route, size_t max_count)
+{
+    py::list frames;
+    DispatchedFrame frame;
+    while (frames.size() < max_count && route.queue.pop(frame)) {
+        frames.append(py::make_tuple(
+            frame.header,
+            py::bytes(reinterpret_cast<const char*>(frame.message), frame.length)));
+    }
+    return frames;
+}
+
+uint32_t RF24NetworkWrapper::dispatch()
+{
+    // a callback may change the routes, so the callbacks are invoked with a copy of the routes
+    std::vector<std::shared_ptr<DispatchRoute>> current;
+    {
+        RadioLock lock(spi_mutex);
+        sort_frames();
+        current = routes;
+    }
+    uint32_t delivered = 0;
+    for (auto& route : current) {
+        if (route->callback.is_none())
+            continue;
+        py::list frames = pop_frames(*route, route->queue.size());
+        if (!frames.size())
+            continue;
+        delivered += static_cast<uint32_t>(frames.size());
+        route->callback(frames);
+    }
+    RadioLock lock(spi_mutex);
+    frames_taken();
+    return delivered;
+}
+
+py::list RF24NetworkWrapper::pop_dispatched(uint8_t type, size_t max_count)
+{
+    std::shared_ptr<DispatchRoute> route;
+    {
+        RadioLock lock(spi_mutex);
+        if (route_of[type] != NO_ROUTE)
+            route = routes[route_of[type]];
+    }
+    if (!route)
+        throw py::value_error("header type " + std::to_string(type) + " has no dispatch route");
+    py::list frames = pop_frames(*route, max_count);
+    RadioLock lock(spi_mutex);
+    frames_taken();
+    return frames;
+}
+
+void RF24NetworkWrapper::pump_loop(std::chrono::microseconds poll_interval)
+{
+    while (pump_running.load(std::memory_order_acquire)) {
+        uint8_t type;
+        {
+            std::lock_guard<std::mutex> lock(spi_mutex);
+            RegistersChanged<RF24NetworkWrapper> changed(*this); // routing may transmit (and resume listening)
+            type = update();
+            if (!frames_signaled && has_frames()) {
+                uint64_t increment = 1;
+                ssize_t written = ::write(frames_fd, &increment, sizeof(increment));
+                (void)written; // only fails if the counter would overflow (it is already readable)
+                frames_signaled = true;
+            }
+        }
+        if (!type)
+            std::this_thread::sleep_for(poll_interval);
+    }
+}
+
 void init_rf24network(py::module& m)
 {
     // **************** Module level constants *********************
@@ -152,11 +338,11 @@ void init_rf24network(py::module& m)
 
             :param RF24 radio: The `RF24` object used to control the radio transceiver.
         )docstr",
-             py::arg("radio"))
+             py::arg("radio"), py::keep_alive<1, 2>())
 
         // *****************************************************************************
 
-        .def("available", &RF24NetworkWrapper::available, R"docstr(
+        .def("available", spi_locked<RF24NetworkWrapper>(&RF24NetworkWrapper::available), R"docstr(
             available() -> bool
 
             :Returns: `True` if there is a frame in the queue, otherwise `False`.
@@ -164,7 +350,7 @@ void init_rf24network(py::module& m)
 
         // *****************************************************************************
 
-        .def("begin", static_cast<void (RF24NetworkWrapper::*)(uint16_t)>(&RF24NetworkWrapper::begin), R"docstr(
+        .def("begin", gil_released<RF24NetworkWrapper>(static_cast<void (RF24NetworkWrapper::*)(uint16_t)>(&RF24NetworkWrapper::begin)), R"docstr(
             begin(node_address: int) \
             begin(channel: int, node_address: int)
 
@@ -185,6 +371,8 @@ void init_rf24network(py::module& m)
                     "and change the channel with `RF24.channel`."
                 )
             );
+            RadioLock lock(self.spi_mutex);
+            RegistersChanged<RF24NetworkWrapper> changed(self);
             return self.begin(channel, node_address); }, R"docstr(
             :param int channel: The desired channel used by the network.
 
@@ -198,7 +386,7 @@ void init_rf24network(py::module& m)
 
         // *****************************************************************************
 
-        .def_property("node_address", &RF24NetworkWrapper::get_node_address, static_cast<void (RF24NetworkWrapper::*)(uint16_t)>(&RF24NetworkWrapper::begin), R"docstr(
+        .def_property("node_address", &RF24NetworkWrapper::get_node_address, gil_released<RF24NetworkWrapper>(static_cast<void (RF24NetworkWrapper::*)(uint16_t)>(&RF24NetworkWrapper::begin)), R"docstr(
             The instantiated network node's `Logical Address <logical_address>`. This is a 2-byte integer in octal format.
         )docstr")
 
@@ -235,6 +423,83 @@ void init_rf24network(py::module& m)
 
         // *****************************************************************************
 
+        .def("read_into", &RF24NetworkWrapper::read_into, R"docstr(
+            read_into(buffer: Buffer, offset: int = 0) -> Tuple[RF24NetworkHeader, int]
+
+            Fetch the next available frame received by the network node, copying its message directly
+            from the network layer's frame queue into a pre-allocated buffer. Unlike `read()`, this
+            function does not allocate any memory for the message.
+
+            :param Buffer buffer: A writable and contiguous object that supports python's
+                buffer protocol (ie. a `bytearray`, `memoryview`, `array.array`, `mmap.mmap`,
+                or numpy array).
+            :param int offset: The index (in bytes) of ``buffer`` at which to start writing
+                the message. Defaults to ``0``.
+
+            :Returns: A `tuple` in which
+
+                - index 0 is the frame's `RF24NetworkHeader`
+                - index 1 is the number of bytes written to ``buffer`` (the frame's message size).
+                  Zero is returned if no frame is available.
+            :Raises:
+                - `IndexError` if ``offset`` is outside the ``buffer``'s range.
+                - `ValueError` if there is not enough room in ``buffer`` (after ``offset``)
+                  for the frame's message. In this case, the frame remains in the queue.
+
+            .. code-block:: python
+
+                buffer = bytearray(MAX_PAYLOAD_SIZE)
+                network.update()
+                while network.available():
+                    header, length = network.read_into(buffer)
+                    message = memoryview(buffer)[:length]
+        )docstr",
+             py::arg("buffer"), py::arg("offset") = 0)
+
+        // *****************************************************************************
+
+        .def("read_all", &RF24NetworkWrapper::read_all, R"docstr(
+            read_all(max_frames: int = 65535, buffer: Buffer | None = None) -> Tuple[bytes, Buffer]
+
+            Drain up to ``max_frames`` frames from the network layer's frame queue in 1 call.
+            This is much faster than calling `available()` and `read()` in a python loop because
+            no header object or message object is created for each frame.
+
+            :param int max_frames: The maximum number of frames to read.
+            :param Buffer buffer: A writable and contiguous object that supports python's
+                buffer protocol (ie. a `bytearray` or `memoryview`). The messages are written
+                back-to-back starting at index 0. Fetching stops early when the next message
+                does not fit in the remaining space (leaving the frame in the queue).
+                If this parameter is not specified, a `bytearray` (sized to fit the messages) is
+                returned instead.
+
+            :Returns: A 2-tuple in which
+
+                - index 0 is the packed header array (a `bytes` object). Each frame is described by
+                  7 unsigned 32-bit integers (in the machine's native byte order): the header's
+                  :py:attr:`~pyrf24.RF24NetworkHeader.from_node`,
+                  :py:attr:`~pyrf24.RF24NetworkHeader.to_node`,
+                  :py:attr:`~pyrf24.RF24NetworkHeader.id`,
+                  :py:attr:`~pyrf24.RF24NetworkHeader.type`,
+                  :py:attr:`~pyrf24.RF24NetworkHeader.reserved`,
+                  the offset of the frame's message in the buffer, and the message's length.
+                - index 1 is the buffer of messages (``buffer`` or a new `bytearray`).
+
+            .. code-block:: python
+
+                network.update()
+                headers, messages = network.read_all()
+                records = memoryview(headers).cast("I", (len(headers) // 28, 7))
+                for from_node, to_node, msg_id, msg_type, _, offset, length in records.tolist():
+                    message = messages[offset : offset + length]
+
+                # or with numpy
+                records = numpy.frombuffer(headers, dtype=numpy.uint32).reshape(-1, 7)
+        )docstr",
+             py::arg("max_frames") = 0xFFFF, py::arg("buffer") = py::none())
+
+        // *****************************************************************************
+
         .def("peek", &RF24NetworkWrapper::peek_header, R"docstr(
             peek(header: RF24NetworkHeader) -> int \
             peek(maxlen: int = MAX_PAYLOAD_SIZE) -> Tuple[RF24NetworkHeader, bytearray]
@@ -260,28 +525,179 @@ void init_rf24network(py::module& m)
 
         // *****************************************************************************
 
-        .def("update", &RF24NetworkWrapper::update, R"docstr(
+        .def("peek_into", &RF24NetworkWrapper::peek_into, R"docstr(
+            peek_into(buffer: Buffer, offset: int = 0) -> Tuple[RF24NetworkHeader, int]
+
+            Fetch the next available frame received by the network node into a pre-allocated buffer
+            without removing the frame from the queue. The parameters, return value, and exceptions
+            are the same as `read_into()`.
+        )docstr",
+             py::arg("buffer"), py::arg("offset") = 0)
+
+        // *****************************************************************************
+
+        .def("update", &RF24NetworkWrapper::update_and_dispatch, R"docstr(
             update() -> int
 
             Keep the network layer current. This function should be called regularly in the application.
             For applications that have a long-running operations in 1 "loop"/iteration, then it is advised to call this function more than once.
 
+            The received frames are also moved to their dispatch routes, and the routes' callbacks are invoked
+            (see `add_dispatch()`).
+
             :Returns: The `int` of the last received header's :py:attr:`~pyrf24.RF24NetworkHeader.type`
+
+            .. seealso:: `start()` calls this function continuously from a native background thread.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("start", &RF24NetworkWrapper::start_pump, R"docstr(
+            start(poll_interval_us: int = 250) -> None
+
+            Start a native background thread (the "pump") that calls `update()` continuously, so
+            frames are routed, acknowledged, and reassembled even when python is busy. The thread
+            never acquires the GIL; it shares the radio's lock with `read()`, `write()`, `peek()`,
+            and the other functions of this network node (and its radio).
+
+            The received frames are still fetched with `read()`, `read_into()`, or `read_all()`.
+            Instead of polling `available()`, an application can wait on `frames_fileno`.
+
+            :param int poll_interval_us: The number of microseconds that the pump sleeps after
+                an `update()` that received nothing.
+
+            :raises RuntimeError: if the pump thread is already running.
+
+            .. code-block:: python
+
+                network.begin(0)
+                network.start()
+                selector = selectors.DefaultSelector()
+                selector.register(network.frames_fileno, selectors.EVENT_READ)
+                while selector.select(timeout=1):
+                    headers, messages = network.read_all()
+        )docstr",
+             py::arg("poll_interval_us") = 250)
+
+        // *****************************************************************************
+
+        .def("stop", &RF24NetworkWrapper::stop_pump, R"docstr(
+            stop() -> None
+
+            Stop the pump thread (if running) and wait for it to finish. The frames that were already
+            received remain queued, and the `frames_fileno` remains valid.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("running", &RF24NetworkWrapper::is_pump_running, R"docstr(
+            This read-only `bool` attribute represents if the pump thread (see `start()`) is running.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("frames_fileno", &RF24NetworkWrapper::get_frames_fileno, R"docstr(
+            This read-only `int` attribute is a file descriptor (an eventfd) that is readable while
+            frames received by the pump thread (see `start()`) have not been read.
+            This is ``-1`` until `start()` is called.
+
+            .. code-block:: python
+
+                loop.add_reader(network.frames_fileno, callback)
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("add_dispatch", &RF24NetworkWrapper::add_dispatch, R"docstr(
+            add_dispatch(first_type: int, last_type: int | None = None, callback: Callable[[List[Tuple[RF24NetworkHeader, bytes]]], Any] | None = None, capacity: int = 64) -> None
+
+            Sort the received frames of a range of header types natively, instead of branching on each
+            frame's :py:attr:`~pyrf24.RF24NetworkHeader.type` in python.
+
+            After each `update()` (and each update of the pump thread, see `start()`), every frame in the
+            frame queue is moved to the queue of its type's route. The frames whose type has no route are
+            left for `read()` (and `available()`) in the order they were received.
+
+            :param int first_type: The first header type of the route.
+            :param int last_type: The last header type of the route (inclusive). If this parameter is not
+                specified, then the route only includes ``first_type``. Only user-defined types (in range
+                [0, :py:attr:`~pyrf24.MAX_USER_DEFINED_HEADER_TYPE`]) can be routed; the system types are
+                used by the network (and mesh) layers.
+            :param Callable callback: A function that receives a batch of the route's frames as a `list` of
+                (`RF24NetworkHeader`, `bytes`) tuples. It is called by `update()` and `dispatch()`.
+                If this parameter is not specified, then the frames are fetched with `pop_dispatched()`.
+            :param int capacity: The maximum number of frames kept by the route. Frames received while the
+                route is full are discarded (see `dispatch_dropped`).
+
+            :raises ValueError: if the types are out of range or already have a route.
+
+            .. code-block:: python
+
+                def on_sensors(frames):
+                    for header, message in frames:
+                        print(f"sensor 0o{header.from_node:o}:", message)
+
+                network.add_dispatch(ord("S"), callback=on_sensors)
+                network.add_dispatch(0, 31)  # fetched with network.pop_dispatched(0, 16)
+                while True:
+                    network.update()  # invokes on_sensors() with a batch of frames
+        )docstr",
+             py::arg("first_type"), py::arg("last_type") = py::none(), py::arg("callback") = py::none(), py::arg("capacity") = 64)
+
+        // *****************************************************************************
+
+        .def("clear_dispatch", &RF24NetworkWrapper::clear_dispatch, R"docstr(
+            clear_dispatch() -> None
+
+            Remove all dispatch routes (see `add_dispatch()`). Their frames are discarded.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("dispatch", &RF24NetworkWrapper::dispatch, R"docstr(
+            dispatch() -> int
+
+            Sort the queued frames into their dispatch routes and invoke each route's callback with its batch
+            of frames. This is done by `update()`, but it is useful when the pump thread (see `start()`) calls
+            `update()` or when the frames are received by `RF24Mesh.update()`.
+
+            :Returns: The number of frames delivered to callbacks.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("pop_dispatched", &RF24NetworkWrapper::pop_dispatched, R"docstr(
+            pop_dispatched(type: int, max_count: int) -> List[Tuple[RF24NetworkHeader, bytes]]
+
+            Fetch (and remove) up to ``max_count`` frames from the dispatch route of a header ``type``.
+
+            :Returns: A `list` of (`RF24NetworkHeader`, `bytes`) tuples (oldest first).
+            :raises ValueError: if the ``type`` has no dispatch route.
+        )docstr",
+             py::arg("type"), py::arg("max_count"))
+
+        // *****************************************************************************
+
+        .def_property_readonly("dispatch_dropped", &RF24NetworkWrapper::get_dispatch_dropped, R"docstr(
+            This read-only `int` attribute represents the number of frames discarded because their
+            dispatch route was full.
         )docstr")
 
         // *****************************************************************************
 
         .def("write", &RF24NetworkWrapper::write, R"docstr(
-            write(header: RF24NetworkHeader, buf: Union[bytes, bytearray], write_direct: int = 0o70) -> bool
+            write(header: RF24NetworkHeader, buf: Buffer, write_direct: int = 0o70) -> bool
 
             Send an outgoing frame over the network.
 
             :param RF24NetworkHeader header: The outgoing frame's `RF24NetworkHeader` about the outgoing message.
-            :param bytes,bytearray buf: The outgoing frame's message (AKA buffer).
+            :param Buffer buf: The outgoing frame's message (AKA buffer). Messages longer than 24 bytes
+                are fragmented (up to :py:attr:`~pyrf24.MAX_PAYLOAD_SIZE` bytes).
             :param int write_direct: An optional parameter to route the message directly to a specified node.
                 The default value will invoke automatic routing.
 
             :Returns: `True` if the frame was successfully sent or otherwise `False`.
+            :raises ValueError: if ``buf`` is longer than :py:attr:`~pyrf24.MAX_PAYLOAD_SIZE`.
         )docstr",
              py::arg("header"), py::arg("buf"), py::arg("write_direct") = NETWORK_AUTO_ROUTING)
 
@@ -293,7 +709,7 @@ void init_rf24network(py::module& m)
             default value set by `begin()` or `node_address`.
         )docstr")
 
-        .def("multicastLevel", &RF24NetworkWrapper::multicastLevel, R"docstr(
+        .def("multicastLevel", reconfiguring<RF24NetworkWrapper>(&RF24NetworkWrapper::multicastLevel), R"docstr(
             multicastLevel(level: int)
 
             Set the network level of the instantiated network node used for multicasted frames. This will override the
@@ -310,17 +726,18 @@ void init_rf24network(py::module& m)
         // *****************************************************************************
 
         .def("multicast", &RF24NetworkWrapper::multicast, R"docstr(
-            multicast(header: RF24NetworkHeader, buf: Union[bytes, bytearray], level: int = 7) -> bool
+            multicast(header: RF24NetworkHeader, buf: Buffer, level: int = 7) -> bool
 
             Broadcast a message to all nodes in a network level.
 
             :param RF24NetworkHeader header: The outgoing frame's header. The only value of this
                 object that is not overridden by this function is the `RF24NetworkHeader.type` attribute.
-            :param bytes,bytearray buf: The outgoing frame's message (AKA buffer).
+            :param Buffer buf: The outgoing frame's message (AKA buffer).
             :param int level: The network level to broadcast the message to. If this parameter is not specified,
                 then the current network level of the instantiated node is used (see `multicast_level`).
 
             :Returns: This function will always return `True` as multicasted messages do not use the radio's auto-ack feature.
+            :raises ValueError: if ``buf`` is longer than :py:attr:`~pyrf24.MAX_PAYLOAD_SIZE`.
         )docstr",
              py::arg("header"), py::arg("buf"), py::arg("level") = 7)
 
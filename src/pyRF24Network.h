@@ -3,11 +3,31 @@
 #include <pybind11/pybind11.h>
 #include "pyRF24.h"
 #include <RF24Network.h>
+#include <deque>
 // #include <queue>
 // #include <pybind11/stl.h>
 
 void init_rf24network(py::module& m);
 
+/**
+ * The length of a network message in ``view``. Messages longer than 24 bytes are fragmented,
+ * so the length is only limited by MAX_PAYLOAD_SIZE (which can exceed 255).
+ */
+inline uint16_t message_length(const BufferView& view)
+{
+    if (view.size() > MAX_PAYLOAD_SIZE)
+        throw py::value_error("buf is longer than MAX_PAYLOAD_SIZE");
+    return static_cast<uint16_t>(view.size());
+}
+
+/** A frame moved from the network layer's frame queue to a dispatch route (see RF24NetworkWrapper::add_dispatch()). */
+struct DispatchedFrame
+{
+    RF24NetworkHeader header;
+    uint16_t length;
+    uint8_t message[MAX_PAYLOAD_SIZE];
+};
+
 /*
 namespace pybind11 {
 namespace detail {
@@ -50,41 +70,70 @@ struct RF24NetworkFrameWrapper : public RF24NetworkFrame
 class RF24NetworkWrapper : public RF24Network
 {
 public:
-    RF24NetworkWrapper(RF24Wrapper& _radio) : RF24Network(static_cast<RF24&>(_radio))
+    RF24NetworkWrapper(RF24Wrapper& _radio) : RF24Network(static_cast<RF24&>(_radio)), spi_mutex(_radio.spi_mutex), stats(_radio.stats), py_radio(_radio)
     {
+        memset(route_of, NO_ROUTE, sizeof(route_of));
     }
 
     // needed for polymorphic recognition
-    virtual ~RF24NetworkWrapper() = default;
+    virtual ~RF24NetworkWrapper()
+    {
+        join_pump();
+        close_frames_fd();
+    }
+
+    /** The radio's SPI mutex, which also guards this network layer's frame queue. */
+    std::mutex& spi_mutex;
+
+    /** The radio's SPI operation stats, so this layer's radio (re)configurations are also counted. */
+    RadioStats& stats;
+
+    /** This network layer (re)configures the radio, so the radio's cached registers must be forgotten. */
+    void invalidate_registers()
+    {
+        py_radio.invalidate_registers();
+    }
 
     uint16_t peek_header(RF24NetworkHeader& header)
     {
-        return RF24Network::peek(header);
+        RadioLock lock(spi_mutex);
+        return peek_next(header);
     }
 
     std::tuple<RF24NetworkHeader, py::bytearray> peek_frame(uint16_t maxlen = MAX_PAYLOAD_SIZE)
     {
         RF24NetworkHeader header;
-        maxlen = static_cast<uint16_t>(rf24_min(maxlen, RF24Network::peek(header)));
-        char* buf = new char[maxlen + 1];
-        RF24Network::peek(header, buf, maxlen);
-        py::bytearray py_ba = py::bytearray(buf, maxlen);
-        delete[] buf;
-        return std::tuple<RF24NetworkHeader, py::bytearray>(header, py_ba);
+        uint8_t message[MAX_PAYLOAD_SIZE];
+        {
+            RadioLock lock(spi_mutex);
+            uint16_t length = peek_next(header);
+            maxlen = static_cast<uint16_t>(rf24_min(maxlen, length));
+            peek_next(header, message, maxlen);
+        }
+        return std::tuple<RF24NetworkHeader, py::bytearray>(header, py::bytearray(reinterpret_cast<char*>(message), maxlen));
+    }
+
+    std::tuple<RF24NetworkHeader, uint16_t> peek_into(py::buffer buf, Py_ssize_t offset = 0)
+    {
+        return frame_into(buf, offset, false);
     }
 
 #if defined(RF24NetworkMulticast)
     bool multicast(RF24NetworkHeader header, py::buffer buf, uint8_t level = 7)
     {
-        return RF24Network::multicast(
-            header,
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint16_t>(get_bytes_or_bytearray_ln(buf)),
-            level);
+        // the buffer stays exported (so it cannot be resized) while the GIL is released
+        BufferView view(buf, false);
+        uint16_t length = message_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24NetworkWrapper> changed(*this);
+        return RF24Network::multicast(header, view.data(), length, level);
     }
 
     void set_multicast_level(uint8_t level)
     {
+        RadioLock lock(spi_mutex);
+        RegistersChanged<RF24NetworkWrapper> changed(*this);
         RF24Network::multicastLevel(level);
     }
 
@@ -96,27 +145,280 @@ public:
 
     std::tuple<RF24NetworkHeader, py::bytearray> read(uint16_t maxlen = MAX_PAYLOAD_SIZE)
     {
-        char* buf = new char[maxlen + 1];
+        // the bytearray is created after unlocking spi_mutex (allocating may run python code)
         RF24NetworkHeader header;
-        uint16_t len = RF24Network::read(header, buf, maxlen);
-        py::bytearray py_ba = py::bytearray(buf, len);
-        delete[] buf;
-        return std::tuple<RF24NetworkHeader, py::bytearray>(header, py_ba);
+        uint8_t message[MAX_PAYLOAD_SIZE];
+        {
+            RadioLock lock(spi_mutex);
+            uint16_t length = peek_next(header);
+            maxlen = static_cast<uint16_t>(rf24_min(maxlen, length));
+            read_next(header, message, maxlen);
+            frames_taken();
+        }
+        return std::tuple<RF24NetworkHeader, py::bytearray>(header, py::bytearray(reinterpret_cast<char*>(message), maxlen));
+    }
+
+    std::tuple<RF24NetworkHeader, uint16_t> read_into(py::buffer buf, Py_ssize_t offset = 0)
+    {
+        return frame_into(buf, offset, true);
+    }
+
+    /** The number of ``uint32_t`` fields in each frame's record of read_all()'s header array. */
+    static const size_t FRAME_RECORD_FIELDS = 7;
+
+    std::tuple<py::bytes, py::object> read_all(uint32_t max_frames = 0xFFFF, py::object buf = py::none())
+    {
+        // on Linux, the frame queue is an unbounded std::queue, so a self-allocated buffer grows as needed
+        const bool allocated = buf.is_none();
+        std::vector<uint8_t> messages;
+        std::vector<uint32_t> records;
+        uint32_t used = 0;
+        {
+            std::unique_ptr<BufferView> view;
+            if (!allocated)
+                view.reset(new BufferView(buf, true));
+            RadioLock lock(spi_mutex);
+            RF24NetworkHeader header;
+            while (records.size() / FRAME_RECORD_FIELDS < max_frames && available()) {
+                uint16_t length = peek_next(header);
+                uint8_t* data;
+                if (allocated) {
+                    messages.resize(used + length);
+                    data = messages.data() + used;
+                }
+                else if (view->size() - used < length)
+                    break; // buffer is full (the frame remains queued)
+                else
+                    data = view->data() + used;
+                read_next(header, data, length);
+                const uint32_t record[FRAME_RECORD_FIELDS] = {header.from_node, header.to_node, header.id, header.type, header.reserved, used, length};
+                records.insert(records.end(), record, record + FRAME_RECORD_FIELDS);
+                used += length;
+            }
+            frames_taken();
+        }
+        if (allocated)
+            buf = py::bytearray(reinterpret_cast<const char*>(messages.data()), used);
+        py::bytes headers(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(uint32_t));
+        return std::tuple<py::bytes, py::object>(headers, buf);
     }
 
     bool write(RF24NetworkHeader& header, py::buffer buf, uint16_t writeDirect = NETWORK_AUTO_ROUTING)
     {
-        return RF24Network::write(
-            header,
-            get_bytes_or_bytearray_str(buf),
-            static_cast<uint8_t>(get_bytes_or_bytearray_ln(buf)),
-            writeDirect);
+        // the buffer stays exported (so it cannot be resized) while the GIL is released
+        BufferView view(buf, false);
+        uint16_t length = message_length(view);
+        py::gil_scoped_release release;
+        std::lock_guard<std::mutex> lock(spi_mutex);
+        RegistersChanged<RF24NetworkWrapper> changed(*this);
+        return RF24Network::write(header, view.data(), length, writeDirect);
     }
 
     uint16_t get_node_address()
     {
         return RF24Network::node_address;
     }
+
+    /**
+     * RF24Network::update(), then move the queued frames to their dispatch routes (and top up the radio's
+     * queued ACK payloads, see RF24Wrapper::refill_ack_payloads()). The SPI mutex must be held.
+     */
+    uint8_t update()
+    {
+        uint8_t type = RF24Network::update();
+        py_radio.refill_ack_payloads();
+        sort_frames();
+        return type;
+    }
+
+    /** The binding of update(): also invokes the callbacks of the dispatch routes (see dispatch()). */
+    uint8_t update_and_dispatch()
+    {
+        uint8_t type;
+        bool has_callbacks;
+        {
+            py::gil_scoped_release release;
+            std::lock_guard<std::mutex> lock(spi_mutex);
+            RegistersChanged<RF24NetworkWrapper> changed(*this);
+            type = update();
+            has_callbacks = dispatch_callbacks != 0;
+        }
+        if (has_callbacks)
+            dispatch();
+        return type;
+    }
+
+    void add_dispatch(int first_type, py::object last_type, py::object callback, size_t capacity = 64);
+
+    void clear_dispatch()
+    {
+        // the routes' callbacks are released after unlocking spi_mutex (releasing them may run python code)
+        std::vector<std::shared_ptr<DispatchRoute>> removed;
+        {
+            RadioLock lock(spi_mutex);
+            memset(route_of, NO_ROUTE, sizeof(route_of));
+            removed.swap(routes);
+            dispatch_callbacks = 0;
+        }
+        // dispatch() may still hold the removed routes, so their frames are discarded now
+        for (auto& route : removed)
+            route->queue.clear();
+    }
+
+    /** If a frame is available for read() (see passthrough). The SPI mutex must be held. */
+    bool available()
+    {
+        return !passthrough.empty() || RF24Network::available();
+    }
+
+    /** Invoke the callback of each dispatch route with its batch of frames. Returns the number of frames delivered. */
+    uint32_t dispatch();
+
+    py::list pop_dispatched(uint8_t type, size_t max_count);
+
+    uint32_t get_dispatch_dropped()
+    {
+        return dispatch_dropped.load();
+    }
+
+    void start_pump(uint32_t poll_interval_us = 250)
+    {
+        RadioLock consumer(pump_mutex);
+        if (pump_running.load())
+            throw std::runtime_error("the network pump thread is already running");
+        open_frames_fd();
+        pump_running.store(true);
+        pump = std::thread(&RF24NetworkWrapper::pump_loop, this, std::chrono::microseconds(poll_interval_us));
+    }
+
+    void stop_pump()
+    {
+        RadioLock consumer(pump_mutex);
+        py::gil_scoped_release release;
+        join_pump();
+    }
+
+    bool is_pump_running()
+    {
+        return pump_running.load();
+    }
+
+    int get_frames_fileno()
+    {
+        return frames_fd;
+    }
+
+private:
+    RF24Wrapper& py_radio;
+
+    /** The pump thread (see start_pump()) and its state. */
+    std::thread pump;
+    std::atomic<bool> pump_running{false};
+    /** Serializes the starting/stopping of pump. */
+    std::mutex pump_mutex;
+    /** An eventfd that is readable while the pump has found frames that were not read (or dispatched) yet. */
+    int frames_fd = -1;
+    /** If frames_fd is readable (guarded by spi_mutex). */
+    bool frames_signaled = false;
+
+    /** Call RF24Network::update() until pump_running is cleared. Runs without the GIL. */
+    void pump_loop(std::chrono::microseconds poll_interval);
+
+    /** Stop the pump thread (if running). The thread never acquires the GIL. */
+    void join_pump()
+    {
+        pump_running.store(false, std::memory_order_release);
+        if (pump.joinable())
+            pump.join();
+    }
+
+    /** Create frames_fd (if not already created). Raises OSError on failure (requires the GIL). */
+    void open_frames_fd();
+
+    void close_frames_fd();
+
+    /** If frames are queued for read() or a dispatch route. The SPI mutex must be held. */
+    bool has_frames();
+
+    /** Make frames_fd unreadable if all frames were read. The SPI mutex must be held. */
+    void frames_taken();
+
+    /** The frames of a range of header types, and the python callback (if any) that consumes them. */
+    struct DispatchRoute
+    {
+        DispatchRoute(uint8_t _first, uint8_t _last, py::object _callback, size_t capacity)
+            : first(_first), last(_last), callback(_callback), queue(capacity)
+        {
+        }
+
+        uint8_t first;
+        uint8_t last;
+        py::object callback;
+        BoundedQueue<DispatchedFrame> queue;
+    };
+
+    /** A route_of value for header types without a dispatch route. */
+    static const uint8_t NO_ROUTE = 0xFF;
+    /**
+     * The dispatch routes (guarded by spi_mutex). Shared so that a route outlives its removal while
+     * dispatch() or pop_dispatched() uses it (without holding spi_mutex).
+     */
+    std::vector<std::shared_ptr<DispatchRoute>> routes;
+    /** The index in routes of each header type's route (guarded by spi_mutex). */
+    uint8_t route_of[256];
+    /** The number of routes that have a callback (guarded by spi_mutex). */
+    size_t dispatch_callbacks = 0;
+    /** The number of frames discarded because their route's queue was full. */
+    std::atomic<uint32_t> dispatch_dropped{0};
+    /**
+     * The frames without a dispatch route that sort_frames() took from the frame queue (guarded by
+     * spi_mutex). They precede the frames still in the frame queue, so they are read first.
+     */
+    std::deque<DispatchedFrame> passthrough;
+
+    /**
+     * Like RF24Network::peek(), but for the next frame of passthrough or the frame queue: copy up to
+     * ``maxlen`` bytes of its message (if any) and return the message's length. The SPI mutex must be held.
+     */
+    uint16_t peek_next(RF24NetworkHeader& header, uint8_t* message = nullptr, uint16_t maxlen = 0);
+
+    /**
+     * Like RF24Network::read(), but for the next frame of passthrough or the frame queue: copy up to
+     * ``maxlen`` bytes of its message and return the number of bytes copied. The SPI mutex must be held.
+     */
+    uint16_t read_next(RF24NetworkHeader& header, uint8_t* message, uint16_t maxlen);
+
+    /**
+     * Move all frames in the frame queue to their dispatch routes. The frames without a route are moved to
+     * passthrough (so the frames left for read() keep their order). The SPI mutex must be held.
+     */
+    void sort_frames();
+
+    /** Pop up to ``max_count`` frames of ``route`` as a list of (header, message) tuples. */
+    static py::list pop_frames(DispatchRoute& route, size_t max_count);
+
+    /**
+     * Copy the next available frame's message from the frame queue into ``buf`` (at ``offset``),
+     * removing the frame from the queue if ``consume`` is true. Nothing is allocated.
+     */
+    std::tuple<RF24NetworkHeader, uint16_t> frame_into(py::buffer buf, Py_ssize_t offset, bool consume)
+    {
+        BufferView view(buf, true);
+        if (offset < 0 || offset > view.size())
+            throw py::index_error("offset is out of the buffer's range");
+        RF24NetworkHeader header;
+        RadioLock lock(spi_mutex);
+        uint16_t length = peek_next(header);
+        if (view.size() - offset < length)
+            throw py::value_error("buffer is too small for the next available frame's message");
+        if (consume) {
+            read_next(header, view.data() + offset, length);
+            frames_taken();
+        }
+        else
+            peek_next(header, view.data() + offset, length);
+        return std::tuple<RF24NetworkHeader, uint16_t>(header, length);
+    }
 };
 
 #endif // PYRF24NETWORK_H
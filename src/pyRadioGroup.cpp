@@ -0,0 +1,312 @@
+#include "pyRadioGroup.h"
+
+RadioGroup::RadioGroup(py::iterable radios, size_t capacity, uint32_t poll_interval_us)
+    : rx_queue(capacity), poll_interval(poll_interval_us)
+{
+    if (!capacity)
+        throw py::value_error("capacity must be greater than 0");
+    for (py::handle radio : radios) {
+        if (members.size() == 255)
+            throw py::value_error("a RadioGroup can drive up to 255 radios");
+        RF24Wrapper& wrapper = radio.cast<RF24Wrapper&>();
+        for (auto& member : members) {
+            if (&member->radio == &wrapper)
+                throw py::value_error("a radio can only be in a RadioGroup once");
+        }
+        members.emplace_back(new Member(wrapper, py::reinterpret_borrow<py::object>(radio), capacity));
+    }
+    if (members.empty())
+        throw py::value_error("radios must not be empty");
+}
+
+void RadioGroup::start()
+{
+    RadioLock lock(threads_mutex);
+    if (running.load())
+        throw std::runtime_error("the RadioGroup's I/O threads are already running");
+    rx_queue.clear();
+    dropped.store(0);
+    running.store(true);
+    for (size_t i = 0; i < members.size(); ++i) {
+        members[i]->received.store(0);
+        members[i]->sent.store(0);
+        members[i]->failed.store(0);
+        members[i]->thread = std::thread(&RadioGroup::io_loop, this, static_cast<uint8_t>(i));
+    }
+}
+
+GroupTxRequest RadioGroup::tx_request(py::buffer buf, const bool multicast)
+{
+    BufferView view(buf, false);
+    GroupTxRequest request;
+    request.length = static_cast<uint8_t>(rf24_min(view.size(), static_cast<Py_ssize_t>(32)));
+    request.multicast = multicast;
+    memcpy(request.payload, view.data(), request.length);
+    return request;
+}
+
+bool RadioGroup::send(size_t index, py::buffer buf, const bool multicast)
+{
+    if (index >= members.size())
+        throw py::index_error("radio index is out of range");
+    return members[index]->tx_queue.push(tx_request(buf, multicast));
+}
+
+size_t RadioGroup::broadcast(py::buffer buf, const bool multicast)
+{
+    GroupTxRequest request = tx_request(buf, multicast);
+    size_t queued = 0;
+    for (auto& member : members)
+        queued += member->tx_queue.push(request);
+    return queued;
+}
+
+py::list RadioGroup::pop(size_t max_count)
+{
+    py::list records;
+    GroupRxRecord received;
+    while (records.size() < max_count && rx_queue.pop(received)) {
+        const RxRecord& record = received.record;
+        records.append(py::make_tuple(
+            received.radio,
+            record.pipe,
+            py::bytes(reinterpret_cast<const char*>(record.payload), record.length),
+            record.timestamp));
+    }
+    return records;
+}
+
+py::list RadioGroup::get_counters()
+{
+    py::list counters;
+    for (auto& member : members)
+        counters.append(py::make_tuple(member->received.load(), member->sent.load(), member->failed.load()));
+    return counters;
+}
+
+void RadioGroup::io_loop(uint8_t index)
+{
+    Member& member = *members[index];
+    RF24Wrapper& radio = member.radio;
+    GroupRxRecord received;
+    received.radio = index;
+    GroupTxRequest request;
+    while (running.load(std::memory_order_acquire)) {
+        bool busy = false;
+        {
+            std::lock_guard<std::mutex> lock(radio.spi_mutex);
+            {
+                RadioStats::Timer timer(radio.stats, RadioStats::STATUS_POLL);
+                uint32_t read_count = 0;
+                uint8_t pipe = 7;
+                while (radio.RF24::available(&pipe)) {
+                    timer.operation = RadioStats::PAYLOAD_READ;
+                    timer.count = ++read_count;
+                    uint8_t length = radio.rx_payload_length();
+                    if (!length)
+                        break; // RX FIFO was flushed (corrupted payload)
+                    RxRecord& record = received.record;
+                    radio.RF24::read(record.payload, length);
+                    record.timestamp = monotonic_ns();
+                    record.pipe = pipe;
+                    record.length = length;
+                    if (!rx_queue.push(received))
+                        dropped.fetch_add(1);
+                    member.received.fetch_add(1);
+                    busy = true;
+                }
+            }
+            if (busy)
+                radio.refill_ack_payloads();
+            if (member.tx_queue.pop(request)) {
+                // switch to TX mode for a batch of queued payloads, then resume listening (if it was)
+                RegistersChanged<RF24Wrapper> changed(radio);
+                RadioStats::Timer timer(radio.stats, RadioStats::PAYLOAD_WRITE);
+                timer.count = 0;
+                bool was_listening = radio.isListening();
+                if (was_listening)
+                    radio.RF24::stopListening();
+                do {
+                    if (radio.RF24::write(request.payload, request.length, request.multicast))
+                        member.sent.fetch_add(1);
+                    else
+                        member.failed.fetch_add(1);
+                } while (++timer.count < TX_BATCH && running.load(std::memory_order_acquire) && member.tx_queue.pop(request));
+                if (was_listening)
+                    radio.RF24::startListening();
+                busy = true;
+            }
+        }
+        if (!busy)
+            std::this_thread::sleep_for(poll_interval);
+        else
+            std::this_thread::yield(); // let other threads that wait for the SPI mutex take it
+    }
+}
+
+void init_radio_group(py::module& m)
+{
+    py::class_<RadioGroup>(m, "RadioGroup", R"docstr(
+        Drive several radios (ie. on different SPI buses) with 1 native I/O thread per radio.
+
+        Each I/O thread drains its radio's RX FIFO into a receive queue shared by all radios
+        (see `pop()`) and transmits the payloads queued for its radio (see `send()` and
+        `broadcast()`). The I/O threads never acquire the GIL, so the SPI transactions of
+        all radios are performed in parallel.
+
+        .. code-block:: python
+
+            radios = [RF24(22, 0), RF24(23, 10), RF24(24, 20)]
+            for channel, radio in zip((10, 40, 70), radios):
+                if not radio.begin():
+                    raise OSError("nRF24L01 hardware isn't responding")
+                radio.channel = channel
+                radio.open_rx_pipe(1, b"1Node")
+                radio.stop_listening(b"2Node")  # sets the TX address
+                radio.listen = True
+
+            group = RadioGroup(radios)
+            group.start()
+            group.broadcast(b"hello")
+            while True:
+                for index, pipe, payload, timestamp in group.pop(16):
+                    print(f"radio {index} pipe {pipe} @ {timestamp} ns:", payload)
+
+        .. important::
+            While the I/O threads are running, the radios can still be (re)configured with
+            their `RF24` objects. But do not use `RF24.available()`, `RF24.read()`, or similar
+            functions to fetch payloads, and do not use `RF24.start_rx_worker()`;
+            the I/O threads will consume the received payloads first.
+    )docstr")
+
+        .def(py::init<py::iterable, size_t, uint32_t>(), R"docstr(
+            __init__(radios: Iterable[RF24], capacity: int = 64, poll_interval_us: int = 250)
+
+            Create a RadioGroup object. The I/O threads are started with `start()`.
+
+            :param Iterable[RF24] radios: The `RF24` objects to drive (up to 255).
+                Each radio should already be configured. Its index in this iterable identifies the
+                radio in the group's other functions.
+            :param int capacity: The maximum number of received payloads (from all radios) that can be
+                stored before they are dropped (see `dropped`). This is also the maximum number of payloads
+                that can be queued for transmission on each radio.
+            :param int poll_interval_us: The number of microseconds that an I/O thread sleeps
+                after finding its radio idle.
+        )docstr",
+             py::arg("radios"), py::arg("capacity") = 64, py::arg("poll_interval_us") = 250)
+
+        // *****************************************************************************
+
+        .def("start", &RadioGroup::start, R"docstr(
+            start() -> None
+
+            Start an I/O thread for each radio. This also clears the receive queue and resets the
+            `counters` and `dropped` attributes.
+
+            :raises RuntimeError: if the I/O threads are already running.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("stop", &RadioGroup::stop, R"docstr(
+            stop() -> None
+
+            Stop the I/O threads (if running). Payloads that were already received can still be fetched
+            with `pop()`. Payloads that were queued (but not transmitted yet) remain queued.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("running", &RadioGroup::is_running, R"docstr(
+            This read-only `bool` attribute represents if the I/O threads are running.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("__len__", &RadioGroup::size, R"docstr(
+            __len__() -> int
+
+            The number of radios in this group.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def("__getitem__", &RadioGroup::get_radio, R"docstr(
+            __getitem__(index: int) -> RF24
+
+            The `RF24` object of the radio at ``index``.
+        )docstr",
+             py::arg("index"))
+
+        // *****************************************************************************
+
+        .def("send", &RadioGroup::send, R"docstr(
+            send(index: int, buf: Buffer, multicast: bool = False) -> bool
+
+            Queue a payload to be transmitted by the radio at ``index``.
+
+            The radio's I/O thread transmits the queued payloads with `RF24.write()` in batches of up to 3
+            payloads, after switching the radio to TX mode (if it was listening). The radio resumes listening
+            after each batch, so received payloads are fetched (and other threads can use the radio) between
+            batches.
+
+            :param int index: The index of the radio.
+            :param Buffer buf: The payload to transmit (truncated to 32 bytes). This can be any contiguous
+                object that supports python's buffer protocol (ie. `bytes`, `bytearray` or `memoryview`).
+            :param bool multicast: Set this parameter to `True` to flag the payload for
+                no acknowledgement. See `RF24.write()` for more detail. Defaults to `False`.
+
+            :Returns: `True` if the payload was queued, or `False` if the radio's TX queue is full.
+
+            .. seealso:: The number of payloads that were sent (or failed) is tracked by `counters`.
+        )docstr",
+             py::arg("index"), py::arg("buf"), py::arg("multicast") = false)
+
+        // *****************************************************************************
+
+        .def("broadcast", &RadioGroup::broadcast, R"docstr(
+            broadcast(buf: Buffer, multicast: bool = False) -> int
+
+            Queue a payload to be transmitted by every radio. See `send()` for more detail.
+
+            :Returns: The number of radios that queued the payload (radios with a full TX queue are skipped).
+        )docstr",
+             py::arg("buf"), py::arg("multicast") = false)
+
+        // *****************************************************************************
+
+        .def("pop", &RadioGroup::pop, R"docstr(
+            pop(max_count: int) -> List[Tuple[int, int, bytes, int]]
+
+            Fetch (and remove) up to ``max_count`` payloads received by any radio.
+
+            :param int max_count: The maximum number of payloads to fetch.
+
+            :Returns: A `list` of payloads (oldest first), in which each payload is described
+                as a 4-tuple:
+
+                - index 0 is the index of the radio that received the payload.
+                - index 1 is the pipe number that received the payload.
+                - index 2 is the payload (`bytes`).
+                - index 3 is the timestamp (in nanoseconds) of when the payload was read from the radio.
+                  This uses the same clock as :py:func:`time.monotonic_ns()`.
+        )docstr",
+             py::arg("max_count"))
+
+        // *****************************************************************************
+
+        .def_property_readonly("counters", &RadioGroup::get_counters, R"docstr(
+            This read-only `list` attribute describes each radio's activity since `start()` as a 3-tuple:
+
+            - index 0 is the number of payloads received.
+            - index 1 is the number of payloads sent.
+            - index 2 is the number of payloads that failed to transmit.
+        )docstr")
+
+        // *****************************************************************************
+
+        .def_property_readonly("dropped", &RadioGroup::get_dropped, R"docstr(
+            This read-only `int` attribute represents the number of received payloads that were discarded
+            because the receive queue was full. This is reset by `start()`.
+        )docstr");
+}
@@ -0,0 +1,135 @@
+#ifndef PYRADIOGROUP_H
+#define PYRADIOGROUP_H
+#include <pybind11/pybind11.h>
+#include "pyRF24.h"
+
+void init_radio_group(py::module& m);
+
+/** A payload received by 1 radio of a RadioGroup. */
+struct GroupRxRecord
+{
+    /** The index of the receiving radio in the RadioGroup. */
+    uint8_t radio;
+    RxRecord record;
+};
+
+/** A payload waiting to be transmitted by 1 radio of a RadioGroup. */
+struct GroupTxRequest
+{
+    uint8_t length;
+    bool multicast;
+    uint8_t payload[32];
+};
+
+/**
+ * Drives several radios (on different SPI buses) with 1 native I/O thread per radio.
+ *
+ * Each thread drains its radio's RX FIFO into a queue shared by all radios and transmits
+ * the payloads queued for its radio. The threads never acquire the GIL, so the SPI
+ * transactions of all radios are performed in parallel.
+ */
+class RadioGroup
+{
+public:
+    RadioGroup(py::iterable radios, size_t capacity = 64, uint32_t poll_interval_us = 250);
+
+    RadioGroup(const RadioGroup&) = delete;
+    RadioGroup& operator=(const RadioGroup&) = delete;
+
+    ~RadioGroup()
+    {
+        join_threads();
+    }
+
+    void start();
+
+    void stop()
+    {
+        RadioLock lock(threads_mutex);
+        py::gil_scoped_release release;
+        join_threads();
+    }
+
+    bool is_running()
+    {
+        return running.load();
+    }
+
+    size_t size()
+    {
+        return members.size();
+    }
+
+    py::object get_radio(size_t index)
+    {
+        if (index >= members.size())
+            throw py::index_error("radio index is out of range");
+        return members[index]->py_radio;
+    }
+
+    /** Queue a payload to be transmitted by the radio at ``index``. Returns false if its TX queue is full. */
+    bool send(size_t index, py::buffer buf, const bool multicast = false);
+
+    /** Queue a payload to be transmitted by every radio. Returns the number of radios that queued it. */
+    size_t broadcast(py::buffer buf, const bool multicast = false);
+
+    py::list pop(size_t max_count);
+
+    py::list get_counters();
+
+    uint32_t get_dropped()
+    {
+        return dropped.load();
+    }
+
+private:
+    /** A radio of this group and the state of its I/O thread. */
+    struct Member
+    {
+        Member(RF24Wrapper& _radio, py::object _py_radio, size_t capacity)
+            : radio(_radio), py_radio(_py_radio), tx_queue(capacity), received(0), sent(0), failed(0)
+        {
+        }
+
+        RF24Wrapper& radio;
+        /** Keeps the radio alive while this group exists. */
+        py::object py_radio;
+        std::thread thread;
+        BoundedQueue<GroupTxRequest> tx_queue;
+        std::atomic<uint32_t> received;
+        std::atomic<uint32_t> sent;
+        std::atomic<uint32_t> failed;
+    };
+
+    std::vector<std::unique_ptr<Member>> members;
+    /** The payloads received by all radios (oldest first). */
+    BoundedQueue<GroupRxRecord> rx_queue;
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<bool> running{false};
+    std::chrono::microseconds poll_interval;
+    /** Serializes the starting/stopping of the I/O threads. */
+    std::mutex threads_mutex;
+
+    /**
+     * The maximum number of payloads that an I/O thread transmits while holding its radio's SPI mutex.
+     * Between batches, the mutex is released (for other users of the radio) and the RX FIFO is drained.
+     */
+    static const uint32_t TX_BATCH = 3;
+
+    /** Service the radio at ``index`` until running is cleared. Runs without the GIL. */
+    void io_loop(uint8_t index);
+
+    /** Stop all I/O threads (if running). The threads never acquire the GIL. */
+    void join_threads()
+    {
+        running.store(false, std::memory_order_release);
+        for (auto& member : members) {
+            if (member->thread.joinable())
+                member->thread.join();
+        }
+    }
+
+    static GroupTxRequest tx_request(py::buffer buf, const bool multicast);
+};
+
+#endif // PYRADIOGROUP_H
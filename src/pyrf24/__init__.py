@@ -1,3 +1,6 @@
+import asyncio
+from typing import Optional, Union
+
 from .fake_ble import (
     BATTERY_UUID,
     BLE_FREQ,
@@ -62,6 +65,7 @@ from .pyrf24 import (  # type: ignore
     RF24Mesh,
     RF24Network,
     RF24NetworkHeader,
+    RadioGroup,
     rf24_crclength_e,
     rf24_datarate_e,
     rf24_fifo_state_e,
@@ -69,6 +73,108 @@ from .pyrf24 import (  # type: ignore
     rf24_pa_dbm_e,
 )
 
+if RF24_DRIVER == "SIMULATED":
+    from .pyrf24 import SimulatedMedium, simulated_medium  # type: ignore
+
+
+async def _wait_for_events(radio: RF24, mask: int, timeout: Optional[float]) -> int:
+    """Wait for any of the ``mask`` events observed by the radio's event monitor
+    (without blocking the event loop). Returns 0 if the ``timeout`` elapsed."""
+    loop = asyncio.get_running_loop()
+    fd = radio.event_fileno
+    if fd < 0:
+        raise RuntimeError("the event monitor is not running; use start_event_monitor()")
+    events = radio.take_events(mask)
+    if events:
+        return events
+    deadline = None if timeout is None else loop.time() + timeout
+    while True:
+        ready = loop.create_future()
+
+        def _wake(ready: asyncio.Future = ready):
+            if not ready.done():
+                ready.set_result(None)
+
+        loop.add_reader(fd, _wake)
+        try:
+            remaining = None if deadline is None else max(deadline - loop.time(), 0)
+            await asyncio.wait_for(ready, remaining)
+        except asyncio.TimeoutError:
+            return 0
+        finally:
+            loop.remove_reader(fd)
+        events = radio.take_events(mask)
+        if events:
+            return events
+
+
+async def _aread(
+    self: RF24, length: int = 0, timeout: Optional[float] = None
+) -> Optional[bytearray]:
+    """aread(length: int = 0, timeout: Optional[float] = None) -> Optional[bytearray]
+
+    An awaitable version of `read()` that waits for a payload to be received.
+    Requires `start_event_monitor()` to be called first.
+
+    :param int length: The number of bytes to read. See `read()` for more detail.
+    :param float timeout: The maximum number of seconds to wait. `None` (the default)
+        waits forever.
+
+    :Returns: The received payload, or `None` if the ``timeout`` elapsed.
+
+    .. note:: Only 1 coroutine should await `aread()` or `awrite()` on the same radio.
+    """
+    loop = asyncio.get_running_loop()
+    deadline = None if timeout is None else loop.time() + timeout
+    while not self.available():
+        remaining = None if deadline is None else max(deadline - loop.time(), 0)
+        events = await _wait_for_events(self, int(RF24_RX_DR), remaining)
+        if not events and not self.available():
+            return None
+    return self.read(length)
+
+
+async def _awrite(
+    self: RF24,
+    buf: Union[bytes, bytearray],
+    multicast: bool = False,
+    timeout: Optional[float] = None,
+) -> bool:
+    """awrite(buf: Union[bytes, bytearray], multicast: bool = False, timeout: Optional[float] = None) -> bool
+
+    An awaitable version of `write()` that does not block the event loop while the
+    radio is transmitting. Requires `start_event_monitor()` to be called first.
+
+    :param buf: The payload to transmit. See `write()` for more detail.
+    :param bool multicast: Set this to `True` to disable the automatic ACK for this payload.
+    :param float timeout: The maximum number of seconds to wait. `None` (the default)
+        waits forever.
+
+    :Returns: `True` if the payload was transmitted successfully, otherwise `False`.
+        When the transmission fails, the TX FIFO is flushed (with `flush_tx()`), which
+        also discards any other payloads that were queued in the TX FIFO.
+
+    :raises TimeoutError: if the ``timeout`` elapsed before the transmission
+        succeeded or failed. The TX FIFO is left as is (the payload may still be
+        transmitted); use `flush_tx()` to discard it.
+
+    .. note:: Only 1 coroutine should await `aread()` or `awrite()` on the same radio.
+    """
+    tx_events = int(RF24_TX_DS) | int(RF24_TX_DF)
+    self.take_events(tx_events)  # discard stale events
+    self.start_write(buf, multicast)
+    events = await _wait_for_events(self, tx_events, timeout)
+    if events & int(RF24_TX_DS):
+        return True
+    if not events:
+        raise TimeoutError("the transmission did not finish before the timeout")
+    self.flush_tx()  # the failed payload would otherwise be retransmitted
+    return False
+
+
+RF24.aread = _aread  # type: ignore[method-assign]
+RF24.awrite = _awrite  # type: ignore[method-assign]
+
 __all__ = [
     "BATTERY_UUID",
     "BLE_FREQ",
@@ -121,6 +227,7 @@ __all__ = [
     "RF24Mesh",
     "RF24Network",
     "RF24NetworkHeader",
+    "RadioGroup",
     "ServiceData",
     "TemperatureServiceData",
     "UrlServiceData",
@@ -136,3 +243,6 @@ __all__ = [
     "swap_bits",
     "whitener",
 ]
+
+if RF24_DRIVER == "SIMULATED":
+    __all__ += ["SimulatedMedium", "simulated_medium"]
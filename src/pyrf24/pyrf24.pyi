@@ -1,4 +1,9 @@
-from typing import Literal, overload
+from typing import Any, Callable, Iterable, Literal, overload
+
+try:
+    from collections.abc import Buffer  # type: ignore[attr-defined]
+except ImportError:  # using Python v3.11 or older
+    from typing_extensions import Buffer  # type: ignore
 
 try:
     from warnings import deprecated  # type: ignore[attr-defined]
@@ -7,7 +12,7 @@ except ImportError:  # using Python v3.12 or older
 
 ######### stubs for RF24 bindings ###########################################
 
-RF24_DRIVER: Literal["SPIDEV", "wiringPi", "pigpio", "MRAA", "RPi"]
+RF24_DRIVER: Literal["SPIDEV", "wiringPi", "pigpio", "MRAA", "RPi", "SIMULATED"]
 
 class rf24_crclength_e:
     RF24_CRC_DISABLED: rf24_crclength_e
@@ -73,6 +78,9 @@ RF24_TX_DF: rf24_irq_flags_e = ...
 RF24_IRQ_ALL: rf24_irq_flags_e = ...
 RF24_IRQ_NONE: rf24_irq_flags_e = ...
 
+# every timestamp (of `read_timestamped()`, `rx_worker_pop()`, `rx_worker_pop_pipe()`,
+# `link_decisions()`, and `RadioGroup.pop()`) is in nanoseconds from the same clock as
+# `time.monotonic_ns()` (CLOCK_MONOTONIC)
 class RF24:
     @overload
     def __init__(
@@ -120,12 +128,12 @@ class RF24:
     @deprecated("Use setStatusFlags() instead.")
     def maskIRQ(self, tx_ok: bool, tx_fail: bool, rx_ready: bool) -> None: ...
     @deprecated("Use stop_listening() instead.")
-    def open_tx_pipe(self, address: bytes | bytearray | int) -> None: ...
+    def open_tx_pipe(self, address: Buffer | int) -> None: ...
     @deprecated("Use stopListening() instead.")
-    def openWritingPipe(self, address: bytes | bytearray | int) -> None: ...
-    def open_rx_pipe(self, number: int, address: bytes | bytearray | int) -> None: ...
+    def openWritingPipe(self, address: Buffer | int) -> None: ...
+    def open_rx_pipe(self, number: int, address: Buffer | int) -> None: ...
     def openReadingPipe(
-        self, number: int, address: bytes | bytearray | int
+        self, number: int, address: Buffer | int
     ) -> None: ...
     def powerUp(self) -> None: ...
     def powerDown(self) -> None: ...
@@ -134,8 +142,57 @@ class RF24:
     def print_pretty_details(self) -> None: ...
     def printPrettyDetails(self) -> None: ...
     def read(self, length: int) -> bytearray: ...
+    def read_into(self, buffer: Buffer, offset: int = 0) -> int: ...
+    def read_many(self, max_count: int, buffer: Buffer) -> bytes: ...
+    def attach_irq(self, pin: int, chip: str = "/dev/gpiochip0") -> None: ...
+    def detach_irq(self) -> None: ...
+    def wait_irq(self, timeout_ms: int = -1) -> int: ...
+    def read_timestamped(self) -> list[tuple[int, bytes, int]]: ...
+    def start_event_monitor(self, poll_interval_us: int = 250) -> None: ...
+    def stop_event_monitor(self) -> None: ...
+    @property
+    def event_fileno(self) -> int: ...
+    def take_events(self, mask: int = RF24_IRQ_ALL.value) -> int: ...
+    async def aread(
+        self, length: int = 0, timeout: float | None = None
+    ) -> bytearray | None: ...
+    async def awrite(
+        self,
+        buf: Buffer,
+        multicast: bool = False,
+        timeout: float | None = None,
+    ) -> bool: ...
+    def start_rx_worker(
+        self, capacity: int = 64, poll_interval_us: int = 250, per_pipe: bool = False
+    ) -> None: ...
+    def stop_rx_worker(self) -> None: ...
+    def rx_worker_pop(self, max_count: int) -> list[tuple[int, bytes, int]]: ...
+    @property
+    def rx_worker_running(self) -> bool: ...
+    @property
+    def rx_worker_dropped(self) -> int: ...
+    def rx_worker_pop_pipe(
+        self, pipe: int, max_count: int
+    ) -> list[tuple[int, bytes, int]]: ...
+    @property
+    def rx_worker_weights(self) -> tuple[int, int, int, int, int, int]: ...
+    @rx_worker_weights.setter
+    def rx_worker_weights(self, weights: Iterable[int]) -> None: ...
+    @property
+    def rx_worker_pending(self) -> tuple[int, int, int, int, int, int]: ...
+    @property
+    def rx_worker_pipe_dropped(self) -> tuple[int, int, int, int, int, int]: ...
+    def scan(
+        self,
+        channels: Iterable[int],
+        dwell_us: int = 130,
+        passes: int = 1,
+        out: Buffer | None = None,
+        callback: Callable[[int, bytes], bool | None] | None = None,
+    ) -> Buffer: ...
     def reuse_tx(self) -> None: ...
     def reUseTX(self) -> None: ...
+    def restore_registers(self, blob: Buffer) -> None: ...
     def rxFifoFull(self) -> bool: ...
     def setAddressWidth(self, width: int) -> None: ...
     @overload
@@ -160,24 +217,25 @@ class RF24:
         self, level: rf24_pa_dbm_e, speed: rf24_datarate_e, lna_enable: bool = True
     ) -> None: ...
     def setPayloadSize(self, size: int) -> None: ...
+    def snapshot_registers(self) -> bytes: ...
     def sprintf_pretty_details(self) -> str: ...
     def sprintfPrettyDetails(self) -> str: ...
     def start_const_carrier(self, level: rf24_pa_dbm_e, channel: int) -> None: ...
     def startConstCarrier(self, level: rf24_pa_dbm_e, channel: int) -> None: ...
     def start_fast_write(
         self,
-        buf: bytes | bytearray,
+        buf: Buffer,
         multicast: bool = False,
         start_tx: bool = True,
     ) -> None: ...
     def startFastWrite(
         self,
-        buf: bytes | bytearray,
+        buf: Buffer,
         multicast: bool = False,
         start_tx: bool = True,
     ) -> None: ...
-    def start_write(self, buf: bytes | bytearray, multicast: bool = False) -> bool: ...
-    def startWrite(self, buf: bytes | bytearray, multicast: bool = False) -> bool: ...
+    def start_write(self, buf: Buffer, multicast: bool = False) -> bool: ...
+    def startWrite(self, buf: Buffer, multicast: bool = False) -> bool: ...
     def stop_const_carrier(self) -> None: ...
     def stopConstCarrier(self) -> None: ...
     def testRPD(self) -> bool: ...
@@ -189,13 +247,50 @@ class RF24:
     def what_happened(self) -> tuple[bool, bool, bool]: ...
     @deprecated("Use clearStatusFlags() instead.")
     def whatHappened(self) -> tuple[bool, bool, bool]: ...
-    def write(self, buf: bytes | bytearray, multicast: bool = False) -> bool: ...
-    def write_ack_payload(self, pipe: int, buf: bytes | bytearray) -> bool: ...
-    def writeAckPayload(self, pipe: int, buf: bytes | bytearray) -> bool: ...
-    def write_blocking(self, buf: bytes | bytearray, timeout: int) -> bool: ...
-    def writeBlocking(self, buf: bytes | bytearray, timeout: int) -> bool: ...
-    def write_fast(self, buf: bytes | bytearray, multicast: bool = False) -> bool: ...
-    def writeFast(self, buf: bytes | bytearray, multicast: bool = False) -> bool: ...
+    def write(self, buf: Buffer, multicast: bool = False) -> bool: ...
+    def write_ack_payload(self, pipe: int, buf: Buffer) -> bool: ...
+    def enable_link_adaptation(
+        self,
+        window: int = 32,
+        min_pa_level: rf24_pa_dbm_e = RF24_PA_MIN,
+        max_pa_level: rf24_pa_dbm_e = RF24_PA_MAX,
+        slowest_data_rate: rf24_datarate_e | None = None,
+        fastest_data_rate: rf24_datarate_e | None = None,
+        min_delay: int = 0,
+        max_delay: int = 15,
+        min_count: int = 1,
+        max_count: int = 15,
+    ) -> None: ...
+    def disable_link_adaptation(self) -> None: ...
+    @property
+    def link_adaptation(self) -> bool: ...
+    def link_stats(self) -> dict[bytes, dict[str, Any]]: ...
+    def link_decisions(
+        self,
+    ) -> list[
+        tuple[
+            int,
+            bytes,
+            str,
+            tuple[int, int, rf24_pa_dbm_e, rf24_datarate_e],
+            tuple[int, int, int, int],
+        ]
+    ]: ...
+    def queue_ack_payloads(self, pipe: int, payloads: Iterable[Buffer]) -> int: ...
+    def ack_payloads_queued(self, pipe: int) -> int: ...
+    def clear_ack_payloads(self) -> None: ...
+    def writeAckPayload(self, pipe: int, buf: Buffer) -> bool: ...
+    def write_blocking(self, buf: Buffer, timeout: int) -> bool: ...
+    def writeBlocking(self, buf: Buffer, timeout: int) -> bool: ...
+    def write_fast(self, buf: Buffer, multicast: bool = False) -> bool: ...
+    def writeFast(self, buf: Buffer, multicast: bool = False) -> bool: ...
+    def write_stream(
+        self,
+        buf: Buffer,
+        payload_size: int,
+        multicast: bool = False,
+        max_retries: int = 100,
+    ) -> tuple[int, int, int]: ...
     @property
     def ack_payloads(self) -> bool: ...
     @ack_payloads.setter
@@ -266,11 +361,24 @@ class RF24:
     def rpd(self) -> bool: ...
     @property
     def rx_fifo_full(self) -> bool: ...
+    @property
+    def register_shadow(self) -> bool: ...
+    @register_shadow.setter
+    def register_shadow(self, enable: bool) -> None: ...
+    def resync_registers(self) -> None: ...
+    @property
+    def spi_reads_saved(self) -> int: ...
+    @property
+    def stats_enabled(self) -> bool: ...
+    @stats_enabled.setter
+    def stats_enabled(self, enable: bool) -> None: ...
+    def stats(self) -> dict[str, tuple[int, int, int]]: ...
+    def reset_stats(self) -> None: ...
     def stop_listening(
-        self, tx_address: bytes | bytearray | None | int = None
+        self, tx_address: Buffer | None | int = None
     ) -> None: ...
     def stopListening(
-        self, tx_address: bytes | bytearray | None | int = None
+        self, tx_address: Buffer | None | int = None
     ) -> None: ...
     def start_listening(self) -> None: ...
     def startListening(self) -> None: ...
@@ -285,6 +393,54 @@ class RF24:
     def print_status(self, flags: int) -> None: ...
     def printStatus(self, flags: int) -> None: ...
 
+class RadioGroup:
+    def __init__(
+        self, radios: Iterable[RF24], capacity: int = 64, poll_interval_us: int = 250
+    ) -> None: ...
+    def start(self) -> None: ...
+    def stop(self) -> None: ...
+    @property
+    def running(self) -> bool: ...
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int) -> RF24: ...
+    def send(self, index: int, buf: Buffer, multicast: bool = False) -> bool: ...
+    def broadcast(self, buf: Buffer, multicast: bool = False) -> int: ...
+    def pop(self, max_count: int) -> list[tuple[int, int, bytes, int]]: ...
+    @property
+    def counters(self) -> list[tuple[int, int, int]]: ...
+    @property
+    def dropped(self) -> int: ...
+
+# only available when built with the SIMULATED driver
+class SimulatedMedium:
+    @property
+    def packet_loss(self) -> float: ...
+    @packet_loss.setter
+    def packet_loss(self, probability: float) -> None: ...
+    @property
+    def path_loss(self) -> float: ...
+    @path_loss.setter
+    def path_loss(self, attenuation: float) -> None: ...
+    @property
+    def latency(self) -> int: ...
+    @latency.setter
+    def latency(self, delay: int) -> None: ...
+    def seed(self, value: int) -> None: ...
+    def set_link(
+        self, transmitter: int, receiver: int, packet_loss: float, path_loss: float
+    ) -> None: ...
+    def clear_links(self) -> None: ...
+    @property
+    def time_us(self) -> int: ...
+    def advance(self, duration_us: int) -> None: ...
+    @property
+    def collisions(self) -> int: ...
+    @property
+    def lost_frames(self) -> int: ...
+    def reset_counters(self) -> None: ...
+
+simulated_medium: SimulatedMedium
+
 ######### stubs for RF24Network bindings ###########################################
 
 MAX_USER_DEFINED_HEADER_TYPE: int = 127
@@ -361,7 +517,7 @@ class RF24Network:
     def is_address_valid(self, address: int) -> bool: ...
     def is_valid_address(self, address: int) -> bool: ...
     def multicast(
-        self, header: RF24NetworkHeader, buf: bytes | bytearray, level: int = 7
+        self, header: RF24NetworkHeader, buf: Buffer, level: int = 7
     ) -> bool: ...
     def multicastLevel(self, level: int) -> None: ...
     # @overload
@@ -372,13 +528,42 @@ class RF24Network:
     def peek(
         self, maxlen: int = MAX_PAYLOAD_SIZE
     ) -> tuple[RF24NetworkHeader, bytearray]: ...
+    def peek_into(
+        self, buffer: Buffer, offset: int = 0
+    ) -> tuple[RF24NetworkHeader, int]: ...
     def read(
         self, maxlen: int = MAX_PAYLOAD_SIZE
     ) -> tuple[RF24NetworkHeader, bytearray]: ...
+    def read_into(
+        self, buffer: Buffer, offset: int = 0
+    ) -> tuple[RF24NetworkHeader, int]: ...
+    def read_all(
+        self, max_frames: int = 65535, buffer: Buffer | None = None
+    ) -> tuple[bytes, Buffer]: ...
     def set_multicast_level(self, level: int) -> None: ...
     def update(self) -> int: ...
+    def start(self, poll_interval_us: int = 250) -> None: ...
+    def stop(self) -> None: ...
+    @property
+    def running(self) -> bool: ...
+    @property
+    def frames_fileno(self) -> int: ...
+    def add_dispatch(
+        self,
+        first_type: int,
+        last_type: int | None = None,
+        callback: Callable[[list[tuple[RF24NetworkHeader, bytes]]], Any] | None = None,
+        capacity: int = 64,
+    ) -> None: ...
+    def clear_dispatch(self) -> None: ...
+    def dispatch(self) -> int: ...
+    def pop_dispatched(
+        self, type: int, max_count: int
+    ) -> list[tuple[RF24NetworkHeader, bytes]]: ...
+    @property
+    def dispatch_dropped(self) -> int: ...
     def available(self) -> int: ...
-    def write(self, header: RF24NetworkHeader, buf: bytes | bytearray) -> bool: ...
+    def write(self, header: RF24NetworkHeader, buf: Buffer) -> bool: ...
     @property
     def multicast_relay(self) -> bool: ...
     @multicast_relay.setter
@@ -492,11 +677,11 @@ class RF24Mesh:
     def update(self) -> int: ...
     @overload
     def write(
-        self, buf: bytes | bytearray, message_type: int, to_node_id: int = 0
+        self, buf: Buffer, message_type: int, to_node_id: int = 0
     ) -> bool: ...
     @overload
     def write(
-        self, to_node: int, buf: bytes | bytearray, message_type: int
+        self, to_node: int, buf: Buffer, message_type: int
     ) -> bool: ...
     @property
     def mesh_address(self) -> int: ...
@@ -0,0 +1,47 @@
+/**
+ * Configure the RF24 library to use a simulated nRF24L01+ (see nrf24_model.h).
+ * No radio hardware is needed.
+ */
+#ifndef RF24_UTILITY_SIMULATED_RF24_ARCH_CONFIG_H_
+#define RF24_UTILITY_SIMULATED_RF24_ARCH_CONFIG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "spi.h"
+#include "gpio.h"
+#include "compatibility.h"
+
+#define _SPI spi
+
+#define HIGH             1
+#define LOW              0
+#define _BV(x)           (1 << (x))
+#define pgm_read_word(p) (*(const unsigned short*)(p))
+#define pgm_read_byte(p) (*(const unsigned char*)(p))
+#define pgm_read_ptr(p)  (*(void* const*)(p))
+
+#define PSTR(x)   (x)
+#define printf_P  printf
+#define sprintf_P sprintf
+#define strlen_P  strlen
+#define PROGMEM
+#define PRIPSTR "%s"
+
+#ifdef SERIAL_DEBUG
+    #define IF_SERIAL_DEBUG(x) ({ x; })
+#else
+    #define IF_SERIAL_DEBUG(x)
+#endif
+
+#define INPUT  GPIO::DIRECTION_IN
+#define OUTPUT GPIO::DIRECTION_OUT
+
+#define digitalWrite(pin, value) GPIO::write(pin, value)
+#define pinMode(pin, direction)  GPIO::open(pin, direction)
+#define delay(milisec)           __msleep(milisec)
+#define delayMicroseconds(usec)  __usleep(usec)
+#define millis()                 __millis()
+
+#endif // RF24_UTILITY_SIMULATED_RF24_ARCH_CONFIG_H_
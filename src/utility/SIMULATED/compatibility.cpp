@@ -0,0 +1,29 @@
+#include "compatibility.h"
+#include "nrf24_model.h"
+
+// the delays advance the simulated Medium's virtual clock (see nrf24_model.h) instead of sleeping
+
+void __msleep(int milisec)
+{
+    __usleep(milisec * 1000);
+}
+
+void __usleep(int microsec)
+{
+    if (microsec <= 0)
+        return;
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    medium.elapse(static_cast<uint64_t>(microsec) * 1000);
+}
+
+void __start_timer()
+{
+}
+
+uint32_t __millis()
+{
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    return static_cast<uint32_t>(medium.now() / 1000000);
+}
@@ -0,0 +1,18 @@
+/**
+ * Timing functions used by the RF24 library on Linux.
+ * These follow the simulated Medium's virtual clock (see nrf24_model.h).
+ */
+#ifndef RF24_UTILITY_SIMULATED_COMPATIBILITY_H_
+#define RF24_UTILITY_SIMULATED_COMPATIBILITY_H_
+
+#include <cstdint>
+
+void __msleep(int milisec);
+
+void __usleep(int microsec);
+
+void __start_timer();
+
+uint32_t __millis();
+
+#endif // RF24_UTILITY_SIMULATED_COMPATIBILITY_H_
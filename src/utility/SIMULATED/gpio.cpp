@@ -0,0 +1,42 @@
+#include "gpio.h"
+#include "nrf24_model.h"
+
+GPIO::GPIO()
+{
+}
+
+void GPIO::open(rf24_gpio_pin_t port, int DDR)
+{
+    if (DDR != DIRECTION_OUT)
+        return;
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    medium.bind_ce(port);
+}
+
+void GPIO::close(rf24_gpio_pin_t port)
+{
+    (void)port; // the CE pin stays connected to its radio
+}
+
+int GPIO::read(rf24_gpio_pin_t port)
+{
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    rf24_sim::Chip* chip = medium.ce_of(port);
+    return chip != nullptr && chip->get_ce() ? OUTPUT_HIGH : OUTPUT_LOW;
+}
+
+void GPIO::write(rf24_gpio_pin_t port, int value)
+{
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    rf24_sim::Chip* chip = medium.ce_of(port);
+    if (chip == nullptr)
+        return;
+    chip->set_ce(value != OUTPUT_LOW, medium.now());
+}
+
+GPIO::~GPIO()
+{
+}
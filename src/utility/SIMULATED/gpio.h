@@ -0,0 +1,36 @@
+/**
+ * A stand-in for the GPIO pins connected to a simulated nRF24L01+ (see nrf24_model.h).
+ * Only the CE pin is modeled.
+ */
+#ifndef RF24_UTILITY_SIMULATED_GPIO_H_
+#define RF24_UTILITY_SIMULATED_GPIO_H_
+
+#include <cstdint>
+
+typedef uint16_t rf24_gpio_pin_t;
+#define RF24_PIN_INVALID 0xFFFF
+
+class GPIO
+{
+public:
+    static const int DIRECTION_OUT = 1;
+    static const int DIRECTION_IN = 0;
+
+    static const int OUTPUT_HIGH = 1;
+    static const int OUTPUT_LOW = 0;
+
+    GPIO();
+
+    /**
+     * Configure a pin. An output pin becomes the CE pin of the radio that most recently
+     * began using its SPI bus (as RF24::begin() does).
+     */
+    static void open(rf24_gpio_pin_t port, int DDR);
+    static void close(rf24_gpio_pin_t port);
+    static int read(rf24_gpio_pin_t port);
+    static void write(rf24_gpio_pin_t port, int value);
+
+    virtual ~GPIO();
+};
+
+#endif // RF24_UTILITY_SIMULATED_GPIO_H_
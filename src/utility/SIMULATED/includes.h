@@ -0,0 +1,12 @@
+/**
+ * Selects the SIMULATED driver. CMake copies this file to utility/includes.h in the build tree.
+ */
+#ifndef RF24_UTILITY_INCLUDES_H_
+#define RF24_UTILITY_INCLUDES_H_
+
+#define RF24_LINUX
+#define RF24_SIMULATED
+
+#include "RF24_arch_config.h"
+
+#endif // RF24_UTILITY_INCLUDES_H_
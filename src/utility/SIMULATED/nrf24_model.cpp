@@ -0,0 +1,700 @@
+#include "nrf24_model.h"
+#include <cstring>
+
+namespace rf24_sim {
+
+namespace {
+
+// register addresses
+enum
+{
+    CONFIG = 0x00,
+    EN_AA = 0x01,
+    EN_RXADDR = 0x02,
+    SETUP_AW = 0x03,
+    SETUP_RETR = 0x04,
+    RF_CH = 0x05,
+    RF_SETUP = 0x06,
+    STATUS = 0x07,
+    OBSERVE_TX = 0x08,
+    RPD = 0x09,
+    RX_ADDR_P0 = 0x0A,
+    RX_ADDR_P1 = 0x0B,
+    RX_ADDR_P2 = 0x0C,
+    TX_ADDR = 0x10,
+    RX_PW_P0 = 0x11,
+    FIFO_STATUS = 0x17,
+    DYNPD = 0x1C,
+    FEATURE = 0x1D,
+};
+
+// commands
+enum
+{
+    R_REGISTER = 0x00,
+    W_REGISTER = 0x20,
+    ACTIVATE = 0x50,
+    R_RX_PL_WID = 0x60,
+    R_RX_PAYLOAD = 0x61,
+    W_TX_PAYLOAD = 0xA0,
+    W_ACK_PAYLOAD = 0xA8,
+    W_TX_PAYLOAD_NO_ACK = 0xB0,
+    FLUSH_TX = 0xE1,
+    FLUSH_RX = 0xE2,
+    REUSE_TX_PL = 0xE3,
+};
+
+// bits of CONFIG, STATUS, FEATURE, and RF_SETUP registers
+const uint8_t PRIM_RX = 0x01;
+const uint8_t PWR_UP = 0x02;
+const uint8_t CRCO = 0x04;
+const uint8_t EN_CRC = 0x08;
+const uint8_t MAX_RT = 0x10;
+const uint8_t TX_DS = 0x20;
+const uint8_t RX_DR = 0x40;
+const uint8_t EN_DYN_ACK = 0x01;
+const uint8_t EN_ACK_PAY = 0x02;
+const uint8_t EN_DPL = 0x04;
+const uint8_t RF_DR_HIGH = 0x08;
+const uint8_t RF_DR_LOW = 0x20;
+const uint8_t CONT_WAVE = 0x80;
+
+/** A pipe tag for TX payloads that are not ACK payloads. */
+const uint8_t NOT_ACK_PAYLOAD = 7;
+
+// timing (in nanoseconds) from the nRF24L01+ datasheet
+const uint64_t T_PD2STBY = 1500000; // power down -> standby (external clock not used)
+const uint64_t T_STBY2A = 130000;   // standby -> TX/RX mode (PLL settling)
+
+/** The received power (in dBm) that asserts the RPD register. */
+const double RPD_THRESHOLD = -64.0;
+
+const uint8_t RESET_VALUES[0x1E] = {
+    0x08, 0x3F, 0x03, 0x03, 0x03, 0x02, 0x0E, 0x0E, 0x00, 0x00, // CONFIG - RPD
+    0xE7, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xE7,                   // RX_ADDR_P0 - TX_ADDR (LSB)
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                         // RX_PW_P0 - RX_PW_P5
+    0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                   // FIFO_STATUS - FEATURE
+};
+
+/** Stands in for a packet's CRC when comparing it to the previously received packet. */
+uint16_t checksum(const Packet& packet)
+{
+    uint16_t result = packet.length;
+    for (uint8_t i = 0; i < packet.length; ++i)
+        result = static_cast<uint16_t>((result << 5 | result >> 11) ^ packet.payload[i]);
+    return result;
+}
+
+} // namespace
+
+// *********************************** Fifo
+
+Packet* Fifo::find(uint8_t pipe)
+{
+    for (uint8_t i = 0; i < count; ++i) {
+        Packet& packet = slots[(head + i) % LEVELS];
+        if (packet.pipe == pipe)
+            return &packet;
+    }
+    return nullptr;
+}
+
+Packet& Fifo::push()
+{
+    Packet& packet = slots[(head + count) % LEVELS];
+    ++count;
+    return packet;
+}
+
+void Fifo::pop()
+{
+    head = (head + 1) % LEVELS;
+    --count;
+}
+
+void Fifo::remove(Packet* packet)
+{
+    // shift newer packets toward the removed packet's slot
+    uint8_t index = static_cast<uint8_t>((packet - slots + LEVELS - head) % LEVELS);
+    for (uint8_t i = index; i + 1 < count; ++i)
+        slots[(head + i) % LEVELS] = slots[(head + i + 1) % LEVELS];
+    --count;
+}
+
+// *********************************** Chip
+
+Chip::Chip(int _id)
+    : id(_id), ce(false), ce_pulse(false), reuse_tx(false), rpd(false), arc(0), plos(0), next_pid(0), standby_at(0), rx_at(0), tx_at(0), tx_phase(TX_START)
+{
+    ack_payload.length = 0;
+    memcpy(registers, RESET_VALUES, sizeof(registers));
+    memset(rx_addr_p0, 0xE7, sizeof(rx_addr_p0));
+    memset(rx_addr_p1, 0xC2, sizeof(rx_addr_p1));
+    memset(tx_addr, 0xE7, sizeof(tx_addr));
+    memset(last_pid, 0xFF, sizeof(last_pid));
+    memset(last_checksum, 0, sizeof(last_checksum));
+}
+
+bool Chip::is_powered() const
+{
+    return registers[CONFIG] & PWR_UP;
+}
+
+bool Chip::is_primary_rx() const
+{
+    return registers[CONFIG] & PRIM_RX;
+}
+
+bool Chip::is_listening(uint64_t now) const
+{
+    return rx_at && now >= rx_at;
+}
+
+bool Chip::uses_dynamic_payloads(uint8_t pipe) const
+{
+    return (registers[FEATURE] & EN_DPL) && (registers[DYNPD] & (1 << pipe));
+}
+
+uint8_t Chip::crc_bytes() const
+{
+    // CRC is forced on if auto-ack is enabled on any pipe
+    if (!(registers[CONFIG] & EN_CRC) && !registers[EN_AA])
+        return 0;
+    return registers[CONFIG] & CRCO ? 2 : 1;
+}
+
+uint8_t Chip::status() const
+{
+    uint8_t rx_pipe = rx_fifo.empty() ? 7 : rx_fifo.front().pipe;
+    return static_cast<uint8_t>((registers[STATUS] & (RX_DR | TX_DS | MAX_RT)) | (rx_pipe << 1) | tx_fifo.full());
+}
+
+uint8_t Chip::fifo_status() const
+{
+    return static_cast<uint8_t>(reuse_tx << 6 | tx_fifo.full() << 5 | tx_fifo.empty() << 4 | rx_fifo.full() << 1 | rx_fifo.empty());
+}
+
+const uint8_t* Chip::address(uint8_t pipe, uint8_t* buf) const
+{
+    if (pipe == 0)
+        return rx_addr_p0;
+    memcpy(buf, rx_addr_p1, 5);
+    if (pipe > 1)
+        buf[0] = registers[RX_ADDR_P0 + pipe];
+    return buf;
+}
+
+uint8_t Chip::read_register(uint8_t reg) const
+{
+    switch (reg) {
+        case STATUS: return status();
+        case OBSERVE_TX: return static_cast<uint8_t>(plos << 4 | arc);
+        case RPD: return rpd || (rx_at && Medium::instance().carrier_detected(*this));
+        case FIFO_STATUS: return fifo_status();
+        default: return reg < sizeof(registers) ? registers[reg] : 0;
+    }
+}
+
+void Chip::write_register(uint8_t reg, const uint8_t* data, uint32_t len, uint64_t now)
+{
+    if (!len)
+        return;
+    uint8_t value = data[0];
+    switch (reg) {
+        case CONFIG: {
+            bool was_powered = is_powered();
+            registers[CONFIG] = value & 0x7F;
+            if (!was_powered && is_powered())
+                standby_at = now + T_PD2STBY;
+            update_mode(now);
+            break;
+        }
+        case EN_AA:
+        case EN_RXADDR:
+        case DYNPD: registers[reg] = value & 0x3F; break;
+        case SETUP_AW: registers[reg] = value & 0x03; break;
+        case RF_CH:
+            registers[reg] = value & 0x7F;
+            plos = 0; // PLOS_CNT is reset by writing to RF_CH
+            break;
+        case STATUS:
+            // write 1 to clear the IRQ flags
+            registers[STATUS] = static_cast<uint8_t>(registers[STATUS] & ~(value & (RX_DR | TX_DS | MAX_RT)));
+            if (value & MAX_RT)
+                schedule_tx(now); // transmissions are blocked while MAX_RT is asserted
+            break;
+        case RX_ADDR_P0:
+        case RX_ADDR_P1:
+        case TX_ADDR: {
+            uint8_t* addr = reg == RX_ADDR_P0 ? rx_addr_p0 : (reg == RX_ADDR_P1 ? rx_addr_p1 : tx_addr);
+            memcpy(addr, data, len < 5 ? len : 5);
+            registers[reg] = addr[0];
+            break;
+        }
+        case OBSERVE_TX:
+        case RPD:
+        case FIFO_STATUS: break; // read-only
+        case FEATURE: registers[reg] = value & 0x07; break;
+        default:
+            if (reg >= RX_PW_P0 && reg < RX_PW_P0 + 6)
+                registers[reg] = value & 0x3F;
+            else if (reg < sizeof(registers))
+                registers[reg] = value;
+            break;
+    }
+}
+
+void Chip::update_mode(uint64_t now)
+{
+    if (!is_powered()) {
+        rx_at = 0;
+        abort_tx();
+        return;
+    }
+    uint64_t settled = (now > standby_at ? now : standby_at) + T_STBY2A;
+    if (is_primary_rx()) {
+        abort_tx();
+        if (!ce)
+            rx_at = 0;
+        else if (!rx_at) {
+            rx_at = settled;
+            rpd = false;
+        }
+    }
+    else {
+        rx_at = 0;
+        schedule_tx(now);
+    }
+}
+
+void Chip::schedule_tx(uint64_t now)
+{
+    if (tx_at || !ce || !is_powered() || is_primary_rx() || tx_fifo.empty() || (registers[STATUS] & MAX_RT))
+        return;
+    tx_at = (now > standby_at ? now : standby_at) + T_STBY2A;
+}
+
+void Chip::set_ce(bool level, uint64_t now)
+{
+    if (level == ce)
+        return;
+    ce = level;
+    // a CE pulse (in TX mode) still sends the payload that was already scheduled
+    ce_pulse = !level && tx_at;
+    update_mode(now);
+}
+
+void Chip::abort_tx()
+{
+    if (tx_phase == TX_ON_AIR)
+        Medium::instance().cancel_frame(*this);
+    tx_phase = TX_START;
+    tx_at = 0;
+}
+
+void Chip::process_event()
+{
+    uint64_t now = tx_at;
+    tx_at = 0;
+    if (tx_fifo.empty()) {
+        abort_tx();
+        return;
+    }
+    Packet& packet = tx_fifo.front();
+    Medium& medium = Medium::instance();
+
+    if (tx_phase == TX_START) {
+        uint64_t end = now + air_time(packet.length);
+        medium.start_frame(*this, now, end);
+        tx_phase = TX_ON_AIR;
+        tx_at = end + medium.latency;
+        return;
+    }
+    if (tx_phase == TX_ACK) {
+        complete_tx(now);
+        return;
+    }
+
+    // TX_ON_AIR: the frame was sent
+    bool expects_ack = !packet.no_ack && (registers[EN_AA] & 1);
+    ack_payload.length = 0;
+    bool acked = medium.end_frame(*this, packet, now, ack_payload);
+    if (!expects_ack) {
+        complete_tx(now);
+        return;
+    }
+    if (acked) {
+        // turn around to RX mode and receive the ACK
+        tx_phase = TX_ACK;
+        tx_at = now + T_STBY2A + air_time(ack_payload.length) + medium.latency;
+        return;
+    }
+    tx_phase = TX_START;
+    if (arc < (registers[SETUP_RETR] & 0x0F)) {
+        ++arc;
+        tx_at = now + ((registers[SETUP_RETR] >> 4) + 1) * 250000ULL;
+        return; // retransmit (even if CE was pulsed)
+    }
+    registers[STATUS] |= MAX_RT;
+    if (plos < 15)
+        ++plos;
+    ce_pulse = false; // the payload stays in the TX FIFO
+}
+
+void Chip::complete_tx(uint64_t now)
+{
+    tx_phase = TX_START;
+    registers[STATUS] |= TX_DS;
+    if (ack_payload.length && !rx_fifo.full()) {
+        Packet& received = rx_fifo.push();
+        received = ack_payload;
+        received.pipe = 0;
+        registers[STATUS] |= RX_DR;
+    }
+    ack_payload.length = 0;
+    ce_pulse = false;
+    if (reuse_tx)
+        return; // a reused payload is sent once per CE pulse
+    tx_fifo.pop();
+    schedule_tx(now); // only if CE is still HIGH
+}
+
+void Chip::detect_carrier(uint8_t rf_channel, double power, uint64_t now)
+{
+    if (is_listening(now) && rf_channel == channel() && power >= RPD_THRESHOLD)
+        rpd = true;
+}
+
+uint8_t Chip::channel() const
+{
+    return registers[RF_CH];
+}
+
+uint8_t Chip::bandwidth() const
+{
+    return (registers[RF_SETUP] & (RF_DR_LOW | RF_DR_HIGH)) == RF_DR_HIGH ? 2 : 1;
+}
+
+double Chip::tx_power() const
+{
+    return -18.0 + 6.0 * ((registers[RF_SETUP] >> 1) & 0x03);
+}
+
+double Chip::sensitivity() const
+{
+    if (registers[RF_SETUP] & RF_DR_LOW)
+        return -94.0; // 250 kbps
+    return registers[RF_SETUP] & RF_DR_HIGH ? -82.0 : -85.0;
+}
+
+bool Chip::is_constant_carrier() const
+{
+    return (registers[RF_SETUP] & CONT_WAVE) && ce && is_powered() && !is_primary_rx();
+}
+
+uint64_t Chip::air_time(uint8_t length) const
+{
+    // preamble + address + packet control field + payload + CRC
+    uint32_t bits = 8 + (registers[SETUP_AW] + 2) * 8 + 9 + length * 8 + crc_bytes() * 8;
+    uint64_t bit_time = 1000; // 1 Mbps
+    if (registers[RF_SETUP] & RF_DR_LOW)
+        bit_time = 4000; // 250 kbps
+    else if (registers[RF_SETUP] & RF_DR_HIGH)
+        bit_time = 500; // 2 Mbps
+    return bits * bit_time;
+}
+
+bool Chip::receive(const Chip& sender, const Packet& packet, uint64_t now, Packet& ack)
+{
+    if (!is_listening(now) || channel() != sender.channel())
+        return false;
+    const uint8_t rate_bits = RF_DR_LOW | RF_DR_HIGH;
+    if ((registers[RF_SETUP] & rate_bits) != (sender.registers[RF_SETUP] & rate_bits)
+        || registers[SETUP_AW] != sender.registers[SETUP_AW] || crc_bytes() != sender.crc_bytes())
+        return false;
+
+    uint8_t width = static_cast<uint8_t>(registers[SETUP_AW] + 2);
+    uint8_t pipe = 0;
+    uint8_t buf[5];
+    for (; pipe < 6; ++pipe) {
+        if ((registers[EN_RXADDR] & (1 << pipe)) && memcmp(address(pipe, buf), sender.tx_addr, width) == 0)
+            break;
+    }
+    if (pipe == 6)
+        return false;
+
+    // the packet's format (and CRC) must match this pipe's payload configuration
+    if (uses_dynamic_payloads(pipe) != sender.uses_dynamic_payloads(0))
+        return false;
+    if (!uses_dynamic_payloads(pipe) && registers[RX_PW_P0 + pipe] != packet.length)
+        return false;
+
+    bool auto_ack = registers[EN_AA] & (1 << pipe);
+    uint16_t packet_checksum = checksum(packet);
+    if (auto_ack && packet.pid == last_pid[pipe] && packet_checksum == last_checksum[pipe])
+        return !packet.no_ack; // a retransmission (its ACK was lost); discard the payload but ACK it
+    if (rx_fifo.full())
+        return false; // the payload is discarded (and not ACK'd)
+
+    Packet& received = rx_fifo.push();
+    received = packet;
+    received.pipe = pipe;
+    registers[STATUS] |= RX_DR;
+    if (auto_ack) {
+        last_pid[pipe] = packet.pid;
+        last_checksum[pipe] = packet_checksum;
+    }
+    if (!auto_ack || packet.no_ack)
+        return false;
+
+    if (registers[FEATURE] & EN_ACK_PAY) {
+        Packet* ack_payload = tx_fifo.find(pipe);
+        if (ack_payload) {
+            ack = *ack_payload;
+            tx_fifo.remove(ack_payload);
+            registers[STATUS] |= TX_DS;
+        }
+    }
+    return true;
+}
+
+void Chip::transfer(const uint8_t* tx, uint8_t* rx, uint32_t len, uint64_t now)
+{
+    if (!len)
+        return;
+    uint8_t command = tx[0];
+    rx[0] = status();
+    const uint8_t* data = tx + 1;
+    uint8_t* out = rx + 1;
+    --len;
+    memset(out, 0, len);
+
+    if (command < W_REGISTER) {
+        uint8_t reg = command & 0x1F;
+        if (reg == RX_ADDR_P0 || reg == RX_ADDR_P1 || reg == TX_ADDR) {
+            const uint8_t* addr = reg == RX_ADDR_P0 ? rx_addr_p0 : (reg == RX_ADDR_P1 ? rx_addr_p1 : tx_addr);
+            memcpy(out, addr, len < 5 ? len : 5);
+        }
+        else if (len)
+            memset(out, read_register(reg), len);
+    }
+    else if (command < ACTIVATE) {
+        write_register(command & 0x1F, data, len, now);
+    }
+    else if (command == R_RX_PL_WID) {
+        if (len)
+            out[0] = rx_fifo.empty() ? 0 : rx_fifo.front().length;
+    }
+    else if (command == R_RX_PAYLOAD) {
+        if (!rx_fifo.empty()) {
+            Packet& packet = rx_fifo.front();
+            memcpy(out, packet.payload, len < packet.length ? len : packet.length);
+            rx_fifo.pop();
+        }
+    }
+    else if (command == W_TX_PAYLOAD || command == W_TX_PAYLOAD_NO_ACK || (command & 0xF8) == W_ACK_PAYLOAD) {
+        if (tx_fifo.full())
+            return;
+        Packet& packet = tx_fifo.push();
+        packet.length = static_cast<uint8_t>(len < 32 ? len : 32);
+        memcpy(packet.payload, data, packet.length);
+        // W_TX_PAYLOAD_NOACK is only enabled by the EN_DYN_ACK feature
+        packet.no_ack = command == W_TX_PAYLOAD_NO_ACK && (registers[FEATURE] & EN_DYN_ACK);
+        if ((command & 0xF8) == W_ACK_PAYLOAD) {
+            packet.pipe = command & 0x07;
+            packet.pid = 0;
+        }
+        else {
+            packet.pipe = NOT_ACK_PAYLOAD;
+            packet.pid = next_pid;
+            next_pid = (next_pid + 1) & 0x03;
+            arc = 0; // ARC_CNT is reset by writing a new payload
+            reuse_tx = false;
+        }
+        schedule_tx(now);
+    }
+    else if (command == FLUSH_TX) {
+        abort_tx();
+        tx_fifo.clear();
+        reuse_tx = false;
+    }
+    else if (command == FLUSH_RX) {
+        rx_fifo.clear();
+    }
+    else if (command == REUSE_TX_PL) {
+        reuse_tx = !tx_fifo.empty();
+    }
+    // ACTIVATE is ignored (the nRF24L01+ does not need it), and NOP only returns the STATUS byte
+}
+
+// *********************************** Medium
+
+Medium& Medium::instance()
+{
+    static Medium medium;
+    return medium;
+}
+
+Medium::Medium() : packet_loss(0.0), path_loss(40.0), latency(0), collisions(0), lost_frames(0), last_attached(nullptr), clock(0)
+{
+}
+
+void Medium::seed(uint32_t value)
+{
+    rng.seed(value);
+}
+
+void Medium::set_link(int transmitter, int receiver, double link_packet_loss, double link_path_loss)
+{
+    Link& path = links[std::make_pair(transmitter, receiver)];
+    path.packet_loss = link_packet_loss;
+    path.path_loss = link_path_loss;
+}
+
+void Medium::clear_links()
+{
+    links.clear();
+}
+
+Medium::Link Medium::link(int transmitter, int receiver) const
+{
+    std::map<std::pair<int, int>, Link>::const_iterator it = links.find(std::make_pair(transmitter, receiver));
+    if (it != links.end())
+        return it->second;
+    Link path;
+    path.packet_loss = packet_loss;
+    path.path_loss = path_loss;
+    return path;
+}
+
+bool Medium::is_lost(const Link& path)
+{
+    if (path.packet_loss <= 0.0)
+        return false; // don't consume a random number
+    if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) >= path.packet_loss)
+        return false;
+    ++lost_frames;
+    return true;
+}
+
+Chip* Medium::attach(int bus)
+{
+    std::unique_ptr<Chip>& chip = chips[bus];
+    if (!chip)
+        chip.reset(new Chip(bus));
+    last_attached = chip.get();
+    return last_attached;
+}
+
+void Medium::bind_ce(uint16_t pin)
+{
+    if (last_attached)
+        ce_pins[pin] = last_attached;
+}
+
+Chip* Medium::ce_of(uint16_t pin)
+{
+    std::map<uint16_t, Chip*>::iterator it = ce_pins.find(pin);
+    return it == ce_pins.end() ? nullptr : it->second;
+}
+
+void Medium::elapse(uint64_t duration)
+{
+    clock += duration;
+    advance(clock);
+}
+
+void Medium::advance(uint64_t now)
+{
+    while (true) {
+        Chip* next = nullptr;
+        for (std::map<int, std::unique_ptr<Chip>>::iterator it = chips.begin(); it != chips.end(); ++it) {
+            uint64_t event = it->second->next_event();
+            if (event && event <= now && (!next || event < next->next_event()))
+                next = it->second.get();
+        }
+        if (!next)
+            return;
+        next->process_event();
+    }
+}
+
+void Medium::start_frame(const Chip& sender, uint64_t now, uint64_t end)
+{
+    Frame frame;
+    frame.sender = &sender;
+    frame.channel = sender.channel();
+    frame.bandwidth = sender.bandwidth();
+    frame.end = end;
+    frame.collided = false;
+    for (std::vector<Frame>::iterator it = frames.begin(); it != frames.end(); ++it) {
+        // a 2 Mbps transmission also occupies the next channel
+        uint8_t low = it->channel < frame.channel ? it->channel : frame.channel;
+        uint8_t high = it->channel < frame.channel ? frame.channel : it->channel;
+        uint8_t low_bandwidth = it->channel < frame.channel ? it->bandwidth : frame.bandwidth;
+        if (it->end > now && high - low < low_bandwidth) {
+            collisions += !it->collided + !frame.collided;
+            it->collided = true;
+            frame.collided = true;
+        }
+    }
+    frames.push_back(frame);
+}
+
+void Medium::cancel_frame(const Chip& sender)
+{
+    for (std::vector<Frame>::iterator it = frames.begin(); it != frames.end(); ++it) {
+        if (it->sender == &sender) {
+            frames.erase(it);
+            return;
+        }
+    }
+}
+
+bool Medium::end_frame(const Chip& sender, const Packet& packet, uint64_t now, Packet& ack)
+{
+    bool collided = false;
+    for (std::vector<Frame>::iterator it = frames.begin(); it != frames.end(); ++it) {
+        if (it->sender == &sender) {
+            collided = it->collided;
+            frames.erase(it);
+            break;
+        }
+    }
+
+    bool acked = false;
+    for (std::map<int, std::unique_ptr<Chip>>::iterator it = chips.begin(); it != chips.end(); ++it) {
+        Chip& receiver = *it->second;
+        if (&receiver == &sender)
+            continue;
+        Link path = link(sender.id, receiver.id);
+        double power = sender.tx_power() - path.path_loss;
+        receiver.detect_carrier(sender.channel(), power, now);
+        if (!receiver.is_listening(now) || collided || power < receiver.sensitivity() || is_lost(path))
+            continue;
+        Packet response;
+        response.length = 0;
+        if (receiver.receive(sender, packet, now, response) && !acked) {
+            // the ACK travels back over the reverse path
+            Link reverse = link(receiver.id, sender.id);
+            if (receiver.tx_power() - reverse.path_loss < sender.sensitivity() || is_lost(reverse))
+                continue;
+            acked = true;
+            ack = response;
+        }
+    }
+    return acked;
+}
+
+bool Medium::carrier_detected(const Chip& receiver) const
+{
+    for (std::map<int, std::unique_ptr<Chip>>::const_iterator it = chips.begin(); it != chips.end(); ++it) {
+        const Chip& sender = *it->second;
+        if (&sender != &receiver && sender.is_constant_carrier() && sender.channel() == receiver.channel()
+            && sender.tx_power() - link(sender.id, receiver.id).path_loss >= RPD_THRESHOLD)
+            return true;
+    }
+    return false;
+}
+
+} // namespace rf24_sim
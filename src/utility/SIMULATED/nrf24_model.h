@@ -0,0 +1,303 @@
+/**
+ * A hardware-free model of the nRF24L01+ transceiver.
+ *
+ * Every simulated radio (a ``Chip``) is attached to one shared ``Medium``. Radios that
+ * share the Medium "hear" each other according to their channel, data rate, address,
+ * CRC, and payload configuration. The Medium also models each frame's air time,
+ * collisions between overlapping frames, received signal strength (for RPD and
+ * sensitivity), and random packet loss (with a seeded random number generator).
+ *
+ * The model is driven by a virtual clock owned by the Medium, not by the host's clock. Each
+ * SPI transaction advances it by the transaction's duration (at the SPI bus speed), and the
+ * delay functions (delay() and delayMicroseconds()) advance it instead of sleeping. Any
+ * clock advance first processes the scheduled transmissions (from any radio) in
+ * chronological order. So, the air time, retries, collisions, and latency of a scenario
+ * only depend on the sequence of radio operations; together with Medium::seed(), a
+ * scenario driven by 1 thread produces the same trace on every run.
+ */
+#ifndef RF24_UTILITY_SIMULATED_NRF24_MODEL_H_
+#define RF24_UTILITY_SIMULATED_NRF24_MODEL_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace rf24_sim {
+
+/** A payload in one of a Chip's FIFOs. */
+struct Packet
+{
+    uint8_t payload[32];
+    uint8_t length;
+    /** RX FIFO: the receiving pipe. TX FIFO: the pipe of an ACK payload (or 7 if not an ACK payload). */
+    uint8_t pipe;
+    /** Transmit this payload without requesting an ACK (W_TX_PAYLOAD_NOACK). */
+    bool no_ack;
+    /** The 2-bit packet identity used to detect retransmissions. */
+    uint8_t pid;
+};
+
+/** A 3-level FIFO as used for the nRF24L01's TX and RX payloads. */
+class Fifo
+{
+public:
+    static const uint8_t LEVELS = 3;
+
+    Fifo() : head(0), count(0)
+    {
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    bool full() const
+    {
+        return count == LEVELS;
+    }
+
+    Packet& front()
+    {
+        return slots[head];
+    }
+
+    const Packet& front() const
+    {
+        return slots[head];
+    }
+
+    /** The oldest packet with the given ``pipe`` tag (or nullptr). */
+    Packet* find(uint8_t pipe);
+
+    /** Append a packet. The FIFO must not be full. */
+    Packet& push();
+    void pop();
+    /** Remove a packet returned by find(). */
+    void remove(Packet* packet);
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    Packet slots[LEVELS];
+    uint8_t head;
+    uint8_t count;
+};
+
+/** The register file, FIFOs, and state machine of 1 simulated nRF24L01+. */
+class Chip
+{
+public:
+    explicit Chip(int _id);
+
+    /** The SPI bus number (CSN pin) that identifies this radio. */
+    const int id;
+
+    /** Exchange ``len`` bytes of an SPI transaction that starts with a command byte. */
+    void transfer(const uint8_t* tx, uint8_t* rx, uint32_t len, uint64_t now);
+    void set_ce(bool level, uint64_t now);
+
+    bool get_ce() const
+    {
+        return ce;
+    }
+
+    /** The time (in nanoseconds) of the next scheduled transmission event (or 0 if none). */
+    uint64_t next_event() const
+    {
+        return tx_at;
+    }
+
+    /** Process the scheduled transmission event (see TxPhase). */
+    void process_event();
+
+    /**
+     * Receive a ``packet`` transmitted by ``sender``.
+     *
+     * @param[out] ack The ACK payload that accompanies this radio's ACK (if any).
+     *     Its ``length`` is left unchanged if there is no ACK payload.
+     * @returns true if this radio responded with an ACK.
+     */
+    bool receive(const Chip& sender, const Packet& packet, uint64_t now, Packet& ack);
+
+    /** Is this radio in RX mode (after PLL settling)? */
+    bool is_listening(uint64_t now) const;
+    /** Latch RPD if this radio is listening while a signal of ``power`` (in dBm) is on its channel. */
+    void detect_carrier(uint8_t rf_channel, double power, uint64_t now);
+
+    uint8_t channel() const;
+    /** The bandwidth (in channels) occupied by a transmission: 2 at 2 Mbps, otherwise 1. */
+    uint8_t bandwidth() const;
+    /** The output power (in dBm) selected by the PA level. */
+    double tx_power() const;
+    /** The minimum received power (in dBm) needed to demodulate at the current data rate. */
+    double sensitivity() const;
+    /** Is this radio transmitting a constant carrier (see RF24::startConstCarrier())? */
+    bool is_constant_carrier() const;
+    /** The time (in nanoseconds) needed to transmit a frame with a payload of ``length`` bytes. */
+    uint64_t air_time(uint8_t length) const;
+
+private:
+    uint8_t status() const;
+    uint8_t fifo_status() const;
+    uint8_t read_register(uint8_t reg) const;
+    const uint8_t* address(uint8_t pipe, uint8_t* buf) const;
+    void write_register(uint8_t reg, const uint8_t* data, uint32_t len, uint64_t now);
+    /** Re-evaluate the operating mode after a change to CONFIG or CE. */
+    void update_mode(uint64_t now);
+    /** Schedule the next transmission if this radio is in TX mode with a payload to send. */
+    void schedule_tx(uint64_t now);
+    /** Cancel the current transmission (if any). */
+    void abort_tx();
+    /** Finish transmitting the head of the TX FIFO (it was ACK'd or no ACK was expected). */
+    void complete_tx(uint64_t now);
+
+    bool is_powered() const;
+    bool is_primary_rx() const;
+    bool uses_dynamic_payloads(uint8_t pipe) const;
+    /** Effective CRC configuration: 0 (disabled), 1 (1 byte), or 2 (2 bytes). */
+    uint8_t crc_bytes() const;
+
+    uint8_t registers[0x1E];
+    uint8_t rx_addr_p0[5];
+    uint8_t rx_addr_p1[5];
+    uint8_t tx_addr[5];
+    Fifo tx_fifo;
+    Fifo rx_fifo;
+    bool ce;
+    bool ce_pulse;
+    bool reuse_tx;
+    bool rpd;
+    uint8_t arc;
+    uint8_t plos;
+    uint8_t next_pid;
+    /** The PID and checksum of the last payload received on each pipe (to discard retransmissions). */
+    uint8_t last_pid[6];
+    uint16_t last_checksum[6];
+    /** When the crystal oscillator is stable after PWR_UP was set. */
+    uint64_t standby_at;
+    /** When RX mode was settled (or 0 if not in RX mode). */
+    uint64_t rx_at;
+    /** When the next transmission event is scheduled (or 0 if none). */
+    uint64_t tx_at;
+
+    enum TxPhase
+    {
+        /** Waiting to start (after PLL settling or the auto-retransmit delay). */
+        TX_START,
+        /** The frame is on air until the event. */
+        TX_ON_AIR,
+        /** The ACK is received at the event. */
+        TX_ACK,
+    };
+    TxPhase tx_phase;
+    /** The ACK payload received for the frame in TX_ACK phase. */
+    Packet ack_payload;
+};
+
+/** The shared RF environment of all simulated radios in this process. */
+class Medium
+{
+public:
+    static Medium& instance();
+
+    /** Guards all simulated radios and the members of this Medium. */
+    std::mutex mutex;
+
+    /** The probability (0 to 1) that any frame (a payload or an ACK) is lost. */
+    double packet_loss;
+    /** The attenuation (in dB) between any 2 radios. */
+    double path_loss;
+    /** An extra delay (in nanoseconds) added to every frame's air time. */
+    uint64_t latency;
+
+    /** The number of frames corrupted by overlapping transmissions. */
+    uint64_t collisions;
+    /** The number of frames dropped by random packet loss. */
+    uint64_t lost_frames;
+
+    /** Restart the random number generator used for packet loss. */
+    void seed(uint32_t value);
+    /**
+     * Override the ``packet_loss`` and ``path_loss`` for frames sent from the radio on SPI bus
+     * ``transmitter`` to the radio on SPI bus ``receiver``.
+     */
+    void set_link(int transmitter, int receiver, double link_packet_loss, double link_path_loss);
+    void clear_links();
+
+    /** Get the radio on the given SPI bus (it is created on first use). The mutex must be held. */
+    Chip* attach(int bus);
+    /** Bind a GPIO pin to the CE pin of the most recently attached radio. The mutex must be held. */
+    void bind_ce(uint16_t pin);
+    /** The radio whose CE pin is bound to ``pin`` (or nullptr). The mutex must be held. */
+    Chip* ce_of(uint16_t pin);
+
+    /** The time (in nanoseconds) of the virtual clock. The mutex must be held. */
+    uint64_t now() const
+    {
+        return clock;
+    }
+
+    /**
+     * Advance the virtual clock by ``duration`` nanoseconds, processing all transmissions
+     * scheduled until then. The mutex must be held.
+     */
+    void elapse(uint64_t duration);
+    /** Put a frame on air (starting ``now``). Overlapping frames on the same channel collide. */
+    void start_frame(const Chip& sender, uint64_t now, uint64_t end);
+    /** Take a frame off air (if it was started). */
+    void cancel_frame(const Chip& sender);
+    /**
+     * Deliver the sender's frame (that ends ``now``) to all other radios.
+     * Returns true if a radio responded with an ACK (that was not lost).
+     */
+    bool end_frame(const Chip& sender, const Packet& packet, uint64_t now, Packet& ack);
+    /** Is a constant carrier received by ``receiver`` with enough power to assert RPD? */
+    bool carrier_detected(const Chip& receiver) const;
+
+private:
+    Medium();
+
+    struct Link
+    {
+        double packet_loss;
+        double path_loss;
+    };
+
+    struct Frame
+    {
+        const Chip* sender;
+        uint8_t channel;
+        uint8_t bandwidth;
+        uint64_t end;
+        bool collided;
+    };
+
+    /** Process all transmissions scheduled up to ``now``. */
+    void advance(uint64_t now);
+
+    Link link(int transmitter, int receiver) const;
+    /** Randomly decide if a frame from ``transmitter`` to ``receiver`` is lost. */
+    bool is_lost(const Link& path);
+
+    std::map<int, std::unique_ptr<Chip>> chips;
+    std::map<uint16_t, Chip*> ce_pins;
+    Chip* last_attached;
+    std::map<std::pair<int, int>, Link> links;
+    std::vector<Frame> frames;
+    std::mt19937 rng;
+    /** The virtual time (in nanoseconds). */
+    uint64_t clock;
+};
+
+} // namespace rf24_sim
+
+#endif // RF24_UTILITY_SIMULATED_NRF24_MODEL_H_
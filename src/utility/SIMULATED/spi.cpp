@@ -0,0 +1,47 @@
+#include "spi.h"
+#include "nrf24_model.h"
+#include <cstring>
+
+SPI::SPI() : chip(nullptr), byte_time(800)
+{
+}
+
+void SPI::begin(int busNo, uint32_t spi_speed)
+{
+    // each transaction advances the Medium's virtual clock by its duration
+    if (spi_speed)
+        byte_time = 8000000000ULL / spi_speed;
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    chip = medium.attach(busNo);
+}
+
+uint8_t SPI::transfer(uint8_t tx)
+{
+    uint8_t rx = 0xFF;
+    transfernb(reinterpret_cast<char*>(&tx), reinterpret_cast<char*>(&rx), 1);
+    return rx;
+}
+
+void SPI::transfernb(char* tbuf, char* rbuf, uint32_t len)
+{
+    if (chip == nullptr) {
+        // no radio is connected; MISO floats HIGH
+        memset(rbuf, 0xFF, len);
+        return;
+    }
+    rf24_sim::Medium& medium = rf24_sim::Medium::instance();
+    std::lock_guard<std::mutex> lock(medium.mutex);
+    // the command takes effect when CSN rises (after all bytes were clocked)
+    medium.elapse(len * byte_time);
+    chip->transfer(reinterpret_cast<uint8_t*>(tbuf), reinterpret_cast<uint8_t*>(rbuf), len, medium.now());
+}
+
+void SPI::transfern(char* buf, uint32_t len)
+{
+    transfernb(buf, buf, len);
+}
+
+SPI::~SPI()
+{
+}
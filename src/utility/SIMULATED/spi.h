@@ -0,0 +1,40 @@
+/**
+ * A stand-in for the SPI bus that is connected to a simulated nRF24L01+ (see nrf24_model.h).
+ */
+#ifndef RF24_UTILITY_SIMULATED_SPI_H_
+#define RF24_UTILITY_SIMULATED_SPI_H_
+
+#include <cstdint>
+
+#ifndef RF24_SPI_SPEED
+    #define RF24_SPI_SPEED 10000000
+#endif
+
+namespace rf24_sim {
+class Chip;
+}
+
+class SPI
+{
+public:
+    SPI();
+
+    /**
+     * Connect to the simulated radio identified by ``busNo``.
+     * RF24::begin() passes its CSN pin number, so each CSN pin number is a different radio.
+     */
+    void begin(int busNo, uint32_t spi_speed = RF24_SPI_SPEED);
+
+    uint8_t transfer(uint8_t tx);
+    void transfernb(char* tbuf, char* rbuf, uint32_t len);
+    void transfern(char* buf, uint32_t len);
+
+    virtual ~SPI();
+
+private:
+    rf24_sim::Chip* chip;
+    /** The time (in nanoseconds) needed to transfer 1 byte at the bus speed. */
+    uint64_t byte_time;
+};
+
+#endif // RF24_UTILITY_SIMULATED_SPI_H_
@@ -0,0 +1,77 @@
+"""
+Round-trip tests of `RF24.snapshot_registers()` and `RF24.restore_registers()`.
+
+These require the pyrf24 package to be built with the ``SIMULATED`` RF24_DRIVER
+(export CMAKE_ARGS="-DRF24_DRIVER=SIMULATED").
+"""
+
+import pytest
+from pyrf24 import (
+    RF24,
+    RF24_DRIVER,
+    RF24_250KBPS,
+    RF24_CRC_8,
+    RF24_PA_MIN,
+)
+
+pytestmark = pytest.mark.skipif(
+    RF24_DRIVER != "SIMULATED", reason="needs pyrf24 built with the SIMULATED driver"
+)
+
+# the read-only registers (STATUS, OBSERVE_TX, RPD, and FIFO_STATUS) are not restored
+READ_ONLY = (0x07, 0x08, 0x09, 0x17)
+
+
+def configurable(blob: bytes) -> bytes:
+    """The bytes of a snapshot that `RF24.restore_registers()` restores."""
+    return bytes(b for i, b in enumerate(blob) if i not in READ_ONLY)
+
+
+@pytest.fixture
+def radio() -> RF24:
+    radio = RF24(22, 0)
+    assert radio.begin()
+    return radio
+
+
+@pytest.mark.parametrize("listening", [False, True])
+def test_round_trip(radio: RF24, listening: bool):
+    radio.stop_listening(b"0Node")
+    radio.open_rx_pipe(0, b"0Node")
+    radio.open_rx_pipe(1, b"1Node")
+    radio.open_rx_pipe(2, b"2")
+    radio.listen = listening
+    snapshot = radio.snapshot_registers()
+    assert len(snapshot) == 45
+
+    radio.channel = 110
+    radio.pa_level = RF24_PA_MIN
+    radio.data_rate = RF24_250KBPS
+    radio.crc_length = RF24_CRC_8
+    radio.payload_size = 8
+    radio.dynamic_payloads = True
+    radio.ack_payloads = True
+    radio.set_auto_ack(3, False)
+    radio.open_rx_pipe(1, b"xNode")
+    radio.open_rx_pipe(5, b"5")
+    radio.listen = not listening
+    assert configurable(radio.snapshot_registers()) != configurable(snapshot)
+
+    radio.restore_registers(snapshot)
+    assert configurable(radio.snapshot_registers()) == configurable(snapshot)
+    # RF24's cached state follows the restored registers
+    assert radio.listen == listening
+    assert radio.payload_size == snapshot[0x11]
+    assert not radio.dynamic_payloads
+    assert not radio.ack_payloads
+
+
+def test_restore_unchanged(radio: RF24):
+    snapshot = radio.snapshot_registers()
+    radio.restore_registers(snapshot)
+    assert configurable(radio.snapshot_registers()) == configurable(snapshot)
+
+
+def test_restore_rejects_bad_blob(radio: RF24):
+    with pytest.raises(ValueError):
+        radio.restore_registers(bytes(44))